@@ -2,8 +2,15 @@
 out vec4 FragColor;
 
 in vec2 TexCoord;
+flat in uint BlockType;
 uniform sampler2D texture1;
 
+// every block shares one texture, tinted per BlockType (air, grass, dirt, stone, log, leaves, coal ore)
+const vec3 blockTints[7] = vec3[7](
+    vec3(1.0), vec3(1.0), vec3(0.65, 0.45, 0.3), vec3(0.55),
+    vec3(0.45, 0.32, 0.2), vec3(0.3, 0.65, 0.25), vec3(0.3)
+);
+
 void main() {
-    FragColor = texture(texture1, TexCoord);
+    FragColor = texture(texture1, TexCoord) * vec4(blockTints[min(BlockType, 6u)], 1.0);
 }
\ No newline at end of file
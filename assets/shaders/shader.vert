@@ -1,13 +1,20 @@
 #version 330 core
-layout(location = 0) in vec3 aPos;
-layout(location = 1) in vec2 aTexCoord;
+// packed chunk vertex, see ChunkVertex in ChunkMesher.h
+layout(location = 0) in uint aVertex;
 
 uniform mat4 view;
 uniform mat4 projection;
+uniform vec3 chunkOrigin;
 
 out vec2 TexCoord;
+flat out uint BlockType;
 
 void main() {
-    gl_Position = projection * view * vec4(aPos, 1.0);
-    TexCoord = aTexCoord;
-}
\ No newline at end of file
+    vec3 corner = vec3(aVertex & 31u, (aVertex >> 5u) & 31u, (aVertex >> 10u) & 31u);
+    vec2 texCoord = vec2((aVertex >> 15u) & 31u, (aVertex >> 20u) & 31u);
+
+    // corners are stored as block index + 0/1, blocks are centered on integer coordinates
+    gl_Position = projection * view * vec4(chunkOrigin + corner - 0.5, 1.0);
+    TexCoord = texCoord;
+    BlockType = aVertex >> 28u;
+}
@@ -0,0 +1,41 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_BENCHMARK_H
+#define MINECRAFT_BENCHMARK_H
+#include <chrono>
+#include <cstdio>
+
+// keeps the compiler from dropping a computation whose result is otherwise unused
+template<typename T>
+inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+template<typename F>
+double measure_seconds(F &&function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline void report_rate(const char *name, const double operations, const double seconds, const char *unit) {
+    std::printf("  %-40s %10.2f M%s/s\n", name, operations / seconds / 1e6, unit);
+}
+
+void benchmark_chunk_map();
+
+void benchmark_chunk_codecs();
+
+void benchmark_noise();
+
+void benchmark_caves();
+
+
+#endif //MINECRAFT_BENCHMARK_H
@@ -0,0 +1,80 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "Benchmark.h"
+#include "../game/world/World.h"
+#include "../game/world/WorldConstants.h"
+#include "../game/world/generation/Noise.h"
+#include "../game/world/generation/TerrainGenerator.h"
+
+// chunks per axis of the cube of chunks carved, all of them below CAVE_MAX_HEIGHT
+#define CAVE_BENCHMARK_SPAN 8
+
+// what the carve stage approximates: both cave fields evaluated at every block
+static void carve_full_resolution(const TerrainGenerator &generator, const ChunkId chunk_id, BlockType *blocks) {
+    const auto [origin_x, origin_y, origin_z] = World::chunk_id_to_world_coordinates(chunk_id);
+    std::array<float, CHUNK_VOLUME> first, second;
+    Noise::gradient3d_grid(generator.seed ^ TerrainGenerator::CAVE_SALT_FIRST, origin_x, origin_y, origin_z,
+                           CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z, 1, CAVE_SCALE, first.data());
+    Noise::gradient3d_grid(generator.seed ^ TerrainGenerator::CAVE_SALT_SECOND, origin_x, origin_y, origin_z,
+                           CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z, 1, CAVE_SCALE, second.data());
+    // the grid is x fastest, then y, then z, the same order as block_index
+    for (uint32_t i = 0; i < CHUNK_VOLUME; i++)
+        if (TerrainGenerator::cave_at(first[i], second[i])) blocks[i] = BlockType::AIR;
+}
+
+// one thread, carving solid stone chunks so every block is a candidate
+void benchmark_caves() {
+    std::printf("caves (single thread, %d chunks)\n", CAVE_BENCHMARK_SPAN * CAVE_BENCHMARK_SPAN * CAVE_BENCHMARK_SPAN);
+
+    const TerrainGenerator generator{WORLD_SEED};
+    constexpr auto chunks = CAVE_BENCHMARK_SPAN * CAVE_BENCHMARK_SPAN * CAVE_BENCHMARK_SPAN;
+    const auto top_chunk_y = CAVE_MAX_HEIGHT / CHUNK_SIZE_Y - 1;
+    const auto chunk_id = [&](const int index) {
+        return World::chunk_id_from_chunk_coords(index % CAVE_BENCHMARK_SPAN,
+                                                 top_chunk_y - index / CAVE_BENCHMARK_SPAN % CAVE_BENCHMARK_SPAN,
+                                                 index / (CAVE_BENCHMARK_SPAN * CAVE_BENCHMARK_SPAN));
+    };
+
+    std::array<BlockType, CHUNK_VOLUME> coarse, full;
+    uint64_t carved = 0, full_carved = 0, agreeing = 0;
+    for (auto index = 0; index < chunks; index++) {
+        std::fill(coarse.begin(), coarse.end(), BlockType::STONE);
+        std::fill(full.begin(), full.end(), BlockType::STONE);
+        generator.carve(chunk_id(index), coarse.data());
+        carve_full_resolution(generator, chunk_id(index), full.data());
+        for (uint32_t i = 0; i < CHUNK_VOLUME; i++) {
+            carved += coarse[i] == BlockType::AIR;
+            full_carved += full[i] == BlockType::AIR;
+            agreeing += coarse[i] == full[i];
+        }
+    }
+
+    const auto coarse_seconds = measure_seconds([&] {
+        for (auto index = 0; index < chunks; index++) {
+            std::fill(coarse.begin(), coarse.end(), BlockType::STONE);
+            generator.carve(chunk_id(index), coarse.data());
+            do_not_optimize(coarse[0]);
+        }
+    });
+    const auto full_seconds = measure_seconds([&] {
+        for (auto index = 0; index < chunks; index++) {
+            std::fill(full.begin(), full.end(), BlockType::STONE);
+            carve_full_resolution(generator, chunk_id(index), full.data());
+            do_not_optimize(full[0]);
+        }
+    });
+
+    const auto blocks = static_cast<double>(chunks) * CHUNK_VOLUME;
+    char name[64];
+    std::snprintf(name, sizeof(name), "lattice every %d blocks + trilinear", CAVE_LATTICE_SPACING);
+    std::printf("  %-40s %10.2f us/chunk\n", name, coarse_seconds / chunks * 1e6);
+    std::printf("  %-40s %10.2f us/chunk\n", "full resolution", full_seconds / chunks * 1e6);
+    std::printf("  carved %.2f%% (full resolution %.2f%%), %.2f%% of the blocks agree\n", 100.0 * carved / blocks,
+                100.0 * full_carved / blocks, 100.0 * agreeing / blocks);
+}
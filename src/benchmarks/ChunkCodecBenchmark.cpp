@@ -0,0 +1,69 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include <vector>
+
+#include "Benchmark.h"
+#include "../game/world/World.h"
+#include "../game/world/generation/TerrainGenerator.h"
+#include "../game/world/storage/ChunkCodec.h"
+
+#define CHUNK_CODEC_BENCHMARK_CHUNKS 512
+#define CHUNK_CODEC_BENCHMARK_ROUNDS 20
+
+static void run(const char *name, const ChunkCodecId codec, const std::vector<BlockStorage> &chunks) {
+    std::vector<std::vector<uint8_t> > encoded(chunks.size());
+    size_t encoded_bytes = 0;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        ChunkCodec::encode(codec, chunks[i], encoded[i]);
+        encoded_bytes += encoded[i].size();
+    }
+
+    std::vector<uint8_t> scratch;
+    const auto encode_seconds = measure_seconds([&] {
+        for (auto round = 0; round < CHUNK_CODEC_BENCHMARK_ROUNDS; round++) {
+            for (auto &blocks: chunks) {
+                scratch.clear();
+                ChunkCodec::encode(codec, blocks, scratch);
+                do_not_optimize(scratch.data());
+            }
+        }
+    });
+
+    BlockStorage decoded;
+    const auto decode_seconds = measure_seconds([&] {
+        for (auto round = 0; round < CHUNK_CODEC_BENCHMARK_ROUNDS; round++) {
+            for (auto &payload: encoded) {
+                ChunkCodec::decode(payload.data(), payload.size(), decoded);
+                do_not_optimize(decoded);
+            }
+        }
+    });
+
+    // throughput in raw block bytes, as if every chunk were a plain CHUNK_VOLUME array
+    const auto raw_bytes = static_cast<double>(CHUNK_VOLUME) * chunks.size() * CHUNK_CODEC_BENCHMARK_ROUNDS;
+    std::printf("%s (%.1f bytes per chunk, ratio %.1f:1)\n", name,
+                static_cast<double>(encoded_bytes) / chunks.size(),
+                static_cast<double>(CHUNK_VOLUME) * chunks.size() / encoded_bytes);
+    report_rate("encode", raw_bytes, encode_seconds, "B");
+    report_rate("decode", raw_bytes, decode_seconds, "B");
+}
+
+void benchmark_chunk_codecs() {
+    const TerrainGenerator generator(WORLD_SEED);
+    std::vector<BlockStorage> chunks(CHUNK_CODEC_BENCHMARK_CHUNKS);
+    // 8x4x16 chunks around the surface
+    for (size_t i = 0; i < chunks.size(); i++) {
+        const auto chunk_x = static_cast<int32_t>(i % 8);
+        const auto chunk_y = static_cast<int32_t>(i / 8 % 4) + TERRAIN_BASE_HEIGHT / CHUNK_SIZE_Y - 2;
+        const auto chunk_z = static_cast<int32_t>(i / 32);
+        generator.generate(World::chunk_id_from_chunk_coords(chunk_x, chunk_y, chunk_z), chunks[i]);
+    }
+
+    std::printf("chunk codecs on generated terrain\n");
+    run("raw", ChunkCodecId::RAW, chunks);
+    run("palette", ChunkCodecId::PALETTE, chunks);
+    run("rle", ChunkCodecId::RLE, chunks);
+    run("lz", ChunkCodecId::LZ, chunks);
+}
@@ -0,0 +1,80 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../game/world/World.h"
+#include "../utils/FlatHashMap.h"
+
+#define CHUNK_MAP_BENCHMARK_SIDE 24
+#define CHUNK_MAP_BENCHMARK_LOOKUPS 20000000
+
+template<typename Map>
+static void run(const char *name, const std::vector<ChunkId> &loaded, const std::vector<ChunkId> &missing) {
+    Map chunks;
+    for (const auto chunk_id: loaded)
+        chunks[chunk_id] = std::make_unique<Chunk>(chunk_id);
+
+    std::vector<ChunkId> shuffled = loaded;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+
+    std::printf("%s (%zu chunks)\n", name, chunks.size());
+
+    const auto random_hits = measure_seconds([&] {
+        size_t found = 0;
+        for (size_t i = 0; i < CHUNK_MAP_BENCHMARK_LOOKUPS; i++)
+            found += chunks.find(shuffled[i % shuffled.size()]) != chunks.end();
+        do_not_optimize(found);
+    });
+    report_rate("random hits", CHUNK_MAP_BENCHMARK_LOOKUPS, random_hits, "lookups");
+
+    // the access pattern of neighbour linking and the occlusion walk
+    const auto neighbor_lookups = measure_seconds([&] {
+        size_t found = 0;
+        size_t lookups = 0;
+        while (lookups < CHUNK_MAP_BENCHMARK_LOOKUPS) {
+            for (const auto chunk_id: loaded) {
+                for (auto face = 0; face < CUBE_FACES; face++) {
+                    found += chunks.find(World::neighbor_chunk_id(chunk_id, face)) != chunks.end();
+                    lookups++;
+                }
+            }
+        }
+        do_not_optimize(found);
+    });
+    report_rate("face neighbours", CHUNK_MAP_BENCHMARK_LOOKUPS, neighbor_lookups, "lookups");
+
+    const auto misses = measure_seconds([&] {
+        size_t found = 0;
+        for (size_t i = 0; i < CHUNK_MAP_BENCHMARK_LOOKUPS; i++)
+            found += chunks.find(missing[i % missing.size()]) != chunks.end();
+        do_not_optimize(found);
+    });
+    report_rate("misses", CHUNK_MAP_BENCHMARK_LOOKUPS, misses, "lookups");
+}
+
+void benchmark_chunk_map() {
+    std::vector<ChunkId> loaded;
+    std::vector<ChunkId> missing;
+    for (auto z = 0; z < CHUNK_MAP_BENCHMARK_SIDE * 2; z++) {
+        for (auto y = 0; y < CHUNK_MAP_BENCHMARK_SIDE; y++) {
+            for (auto x = 0; x < CHUNK_MAP_BENCHMARK_SIDE; x++) {
+                const auto chunk_id = World::chunk_id_from_world_coords({
+                    x * CHUNK_SIZE_X, y * CHUNK_SIZE_Y, z * CHUNK_SIZE_Z
+                });
+                // the far half of the box is never loaded
+                (z < CHUNK_MAP_BENCHMARK_SIDE ? loaded : missing).push_back(chunk_id);
+            }
+        }
+    }
+
+    std::printf("chunk map lookups\n");
+    run<std::unordered_map<ChunkId, std::unique_ptr<Chunk> > >("std::unordered_map", loaded, missing);
+    run<FlatHashMap<ChunkId, std::unique_ptr<Chunk> > >("FlatHashMap", loaded, missing);
+}
@@ -0,0 +1,61 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../game/world/WorldConstants.h"
+#include "../game/world/generation/Noise.h"
+
+#define NOISE_BENCHMARK_CHUNKS 4096
+
+// one thread, so the rates are samples per second per core
+void benchmark_noise() {
+    const auto best = Noise::best_simd();
+    std::printf("noise (single thread, widest supported: %s)\n", Noise::simd_name(best));
+
+    constexpr auto plane = CHUNK_SIZE_X * CHUNK_SIZE_Z;
+    constexpr auto volume = CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z;
+    std::vector<float> reference2d(plane), reference3d(volume), samples(volume);
+    Noise::fbm2d_grid(WORLD_SEED, -40, 17, CHUNK_SIZE_X, CHUNK_SIZE_Z, TERRAIN_SCALE, TERRAIN_OCTAVES,
+                      reference2d.data(), NoiseSimd::SCALAR);
+    Noise::gradient3d_grid(WORLD_SEED, -40, 5, 17, CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z, 1, 32.0f,
+                           reference3d.data(), NoiseSimd::SCALAR);
+
+    for (auto level = 0; level <= static_cast<int>(best); level++) {
+        const auto simd = static_cast<NoiseSimd>(level);
+
+        // every level has to reproduce the scalar terrain exactly
+        Noise::fbm2d_grid(WORLD_SEED, -40, 17, CHUNK_SIZE_X, CHUNK_SIZE_Z, TERRAIN_SCALE, TERRAIN_OCTAVES,
+                          samples.data(), simd);
+        const auto same2d = std::memcmp(samples.data(), reference2d.data(), plane * sizeof(float)) == 0;
+        Noise::gradient3d_grid(WORLD_SEED, -40, 5, 17, CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z, 1, 32.0f,
+                               samples.data(), simd);
+        const auto same3d = std::memcmp(samples.data(), reference3d.data(), volume * sizeof(float)) == 0;
+        if (!same2d || !same3d) std::printf("  %s does not match the scalar noise!\n", Noise::simd_name(simd));
+
+        const auto fbm_seconds = measure_seconds([&] {
+            for (auto chunk = 0; chunk < NOISE_BENCHMARK_CHUNKS; chunk++) {
+                Noise::fbm2d_grid(WORLD_SEED, chunk * CHUNK_SIZE_X, 0, CHUNK_SIZE_X, CHUNK_SIZE_Z, TERRAIN_SCALE,
+                                  TERRAIN_OCTAVES, samples.data(), simd);
+                do_not_optimize(samples[0]);
+            }
+        });
+        const auto gradient_seconds = measure_seconds([&] {
+            for (auto chunk = 0; chunk < NOISE_BENCHMARK_CHUNKS / 16; chunk++) {
+                Noise::gradient3d_grid(WORLD_SEED, chunk * CHUNK_SIZE_X, 0, 0, CHUNK_SIZE_X, CHUNK_SIZE_Y,
+                                       CHUNK_SIZE_Z, 1, 32.0f, samples.data(), simd);
+                do_not_optimize(samples[0]);
+            }
+        });
+
+        const auto name = std::string(Noise::simd_name(simd));
+        report_rate((name + " fbm2d 16x16, " + std::to_string(TERRAIN_OCTAVES) + " octaves").c_str(),
+                    static_cast<double>(plane) * NOISE_BENCHMARK_CHUNKS, fbm_seconds, "samples");
+        report_rate((name + " gradient3d 16x16x16").c_str(),
+                    static_cast<double>(volume) * (NOISE_BENCHMARK_CHUNKS / 16), gradient_seconds, "samples");
+    }
+}
@@ -0,0 +1,18 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+std::vector<std::string> debug_output;
+
+int main() {
+    benchmark_chunk_map();
+    benchmark_chunk_codecs();
+    benchmark_noise();
+    benchmark_caves();
+    return 0;
+}
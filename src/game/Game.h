@@ -11,7 +11,7 @@ struct Game {
     World world;
     Render render;
     std::shared_ptr<Player> player = std::make_shared<
-        Player>(World::generate_entity_id(), "IDjinn", WORLD_SPAWN_COORDS);
+        Player>(World::generate_entity_id(), "IDjinn", world.spawn_point);
 
     Game() : world(OVERWORLD, WORLD_SPAWN_COORDS), render(this->world) {
         world.add_player(player);
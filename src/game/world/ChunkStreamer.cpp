@@ -0,0 +1,114 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ChunkStreamer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "glm/geometric.hpp"
+
+static WorldCoord player_chunk(const Player &player) {
+    // blocks are centered on integer coordinates
+    return World::chunk_id_to_chunk_coords(World::chunk_id_from_world_coords({
+        static_cast<int32_t>(std::floor(player.position.x + 0.5f)),
+        static_cast<int32_t>(std::floor(player.position.y + 0.5f)),
+        static_cast<int32_t>(std::floor(player.position.z + 0.5f))
+    }));
+}
+
+static int32_t distance_squared(const WorldCoord a, const WorldCoord b) {
+    const auto dx = a.x - b.x;
+    const auto dy = a.y - b.y;
+    const auto dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+void ChunkStreamer::update(World &world) {
+    loaded.clear();
+    unloaded.clear();
+
+    if (anchors_changed(world)) rebuild_queues(world);
+
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                              std::chrono::duration<double, std::milli>(budget_ms));
+    const auto out_of_budget = [&] { return std::chrono::steady_clock::now() >= deadline; };
+
+    // unloading first gives its chunks back to the pool before the loads need them
+    while (!unload_queue.empty()) {
+        const auto chunk_id = unload_queue.back();
+        unload_queue.pop_back();
+        if (world.unloadChunk(chunk_id)) unloaded.push_back(chunk_id);
+        // the loads below still run, finish_chunk_loads takes at least one chunk even past the deadline
+        if (out_of_budget()) break;
+    }
+
+    // requests only queue a read on the io thread, capped so that a far away chunk never waits behind hundreds of
+    // requests that were urgent before the player moved
+    while (!load_queue.empty() && world.pending_chunk_loads() < CHUNK_STREAM_MAX_REQUESTS) {
+        world.request_chunk(load_queue.back().chunk_id);
+        load_queue.pop_back();
+    }
+
+    world.finish_chunk_loads(loaded, deadline);
+}
+
+bool ChunkStreamer::anchors_changed(const World &world) const {
+    if (anchors.size() != world.players.size()) return true;
+
+    for (size_t i = 0; i < anchors.size(); i++) {
+        const auto &player = *world.players[i];
+        const auto chunk = player_chunk(player);
+        if (chunk.x != anchors[i].chunk.x || chunk.y != anchors[i].chunk.y || chunk.z != anchors[i].chunk.z)
+            return true;
+        // turning around changes which chunks are in view
+        if (glm::dot(player.cameraFront, anchors[i].front) < CHUNK_STREAM_TURN_COSINE) return true;
+    }
+    return false;
+}
+
+void ChunkStreamer::rebuild_queues(const World &world) {
+    anchors.clear();
+    for (auto &player: world.players)
+        anchors.push_back({player_chunk(*player), player->cameraFront});
+
+    load_queue.clear();
+    const auto load_radius_squared = load_radius * load_radius;
+    for (auto &anchor: anchors) {
+        for (auto dz = -load_radius; dz <= load_radius; dz++) {
+            for (auto dy = -load_radius; dy <= load_radius; dy++) {
+                for (auto dx = -load_radius; dx <= load_radius; dx++) {
+                    const auto distance = dx * dx + dy * dy + dz * dz;
+                    if (distance > load_radius_squared) continue;
+
+                    const auto chunk_id = World::chunk_id_from_chunk_coords(
+                        anchor.chunk.x + dx, anchor.chunk.y + dy, anchor.chunk.z + dz);
+                    if (world.isChunkLoaded(chunk_id)) continue;
+
+                    // chunks behind the camera wait as if they were twice as far away
+                    const auto in_view = glm::dot(glm::vec3(dx, dy, dz), anchor.front) >= 0.0f;
+                    load_queue.push_back({chunk_id, static_cast<float>(in_view ? distance : distance * 4)});
+                }
+            }
+        }
+    }
+    // players close to each other queue the same chunks, the duplicates are skipped by request_chunk
+    std::sort(load_queue.begin(), load_queue.end(), [](const Candidate &a, const Candidate &b) {
+        return a.priority > b.priority;
+    });
+
+    unload_queue.clear();
+    if (anchors.empty()) return;
+
+    const auto unload_radius_squared = unload_radius * unload_radius;
+    for (auto &[chunk_id, chunk]: world.chunks) {
+        const auto coords = World::chunk_id_to_chunk_coords(chunk_id);
+        const auto needed = std::any_of(anchors.begin(), anchors.end(), [&](const Anchor &anchor) {
+            return distance_squared(coords, anchor.chunk) <= unload_radius_squared;
+        });
+        if (!needed) unload_queue.push_back(chunk_id);
+    }
+}
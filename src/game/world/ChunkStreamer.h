@@ -0,0 +1,54 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKSTREAMER_H
+#define MINECRAFT_CHUNKSTREAMER_H
+#include <vector>
+
+#include "World.h"
+
+// Keeps the chunks around every player loaded. Chunks inside load_radius are generated nearest first, with chunks in
+// front of the camera ahead of the ones behind it, and chunks past unload_radius are dropped. The gap between both
+// radii stops chunks on the border from loading and unloading over and over. Loads are requested from the world io
+// thread in priority order. Each update() stops once its time budget is spent, the remaining work carries over to the
+// next frame.
+struct ChunkStreamer {
+    int32_t load_radius = CHUNK_STREAM_LOAD_RADIUS;
+    int32_t unload_radius = CHUNK_STREAM_UNLOAD_RADIUS;
+    double budget_ms = CHUNK_STREAM_BUDGET_MS;
+
+    // chunks loaded/unloaded by the last update()
+    std::vector<ChunkId> loaded{};
+    std::vector<ChunkId> unloaded{};
+
+    void update(World &world);
+
+    [[nodiscard]] size_t pending_loads() const { return load_queue.size(); }
+
+    [[nodiscard]] size_t pending_unloads() const { return unload_queue.size(); }
+
+private:
+    struct Anchor {
+        WorldCoord chunk;
+        glm::vec3 front;
+    };
+
+    struct Candidate {
+        ChunkId chunk_id;
+        float priority;
+    };
+
+    // where the queues were last built from, one per player
+    std::vector<Anchor> anchors{};
+    // sorted so the most urgent chunk is at the back
+    std::vector<Candidate> load_queue{};
+    std::vector<ChunkId> unload_queue{};
+
+    [[nodiscard]] bool anchors_changed(const World &world) const;
+
+    void rebuild_queues(const World &world);
+};
+
+
+#endif //MINECRAFT_CHUNKSTREAMER_H
@@ -4,6 +4,8 @@
 
 #include "World.h"
 
+#include <algorithm>
+
 #include "../../utils/Assert.h"
 
 
@@ -17,13 +19,363 @@ Chunk &World::getChunk(ChunkId chunk_id) {
     return *it->second;
 }
 
-bool World::isChunkLoaded(ChunkId chunk_id) {
+const Chunk &World::getChunk(const ChunkId chunk_id) const {
+    const auto it = chunks.find(chunk_id);
+    ASSERT(it != chunks.end(), "Chunk was not found/loaded");
+    return *it->second;
+}
+
+bool World::isChunkLoaded(const ChunkId chunk_id) const {
     return chunks.find(chunk_id) != chunks.end();
 }
 
+bool World::isChunkInitialized(const ChunkId chunk_id) const {
+    const auto it = chunks.find(chunk_id);
+    return it != chunks.end() && it->second->isInitialized();
+}
+
+size_t World::chunk_memory_usage() const {
+    size_t bytes = 0;
+    for (auto &[chunk_id, chunk]: chunks)
+        if (chunk->isInitialized()) bytes += chunk->blocks.memory_usage();
+    return bytes;
+}
+
+BlockType World::getBlock(const WorldCoord coords) const {
+    const auto it = chunks.find(chunk_id_from_world_coords(coords));
+    if (it == chunks.end() || !it->second->isInitialized()) return BlockType::AIR;
+
+    const auto [origin_x, origin_y, origin_z] = chunk_id_to_world_coordinates(it->first);
+    return it->second->getBlock(coords.x - origin_x, coords.y - origin_y, coords.z - origin_z);
+}
+
+bool World::setBlock(const WorldCoord coords, const BlockType type) {
+    const auto chunk_id = chunk_id_from_world_coords(coords);
+    const auto it = chunks.find(chunk_id);
+    if (it == chunks.end() || !it->second->isInitialized()) return false;
+
+    const auto [origin_x, origin_y, origin_z] = chunk_id_to_world_coordinates(chunk_id);
+    const auto x = coords.x - origin_x;
+    const auto z = coords.z - origin_z;
+    it->second->setBlock(x, coords.y - origin_y, z, type);
+
+    auto &column = *columns.find(column_id(chunk_id))->second;
+    auto &highest = column.highest[ChunkColumn::index(x, z)];
+    if (type != BlockType::AIR) {
+        highest = std::max(highest, coords.y);
+    } else if (coords.y == highest) {
+        highest = scan_column_height(column, chunk_id, x, z, coords.y);
+    }
+    return true;
+}
+
+int32_t World::terrain_height(const int32_t x, const int32_t z) const {
+    const auto chunk_id = chunk_id_from_world_coords({x, 0, z});
+    const auto it = columns.find(column_id(chunk_id));
+    if (it == columns.end()) return generator.height_at(x, z);
+
+    const auto origin = chunk_id_to_world_coordinates(chunk_id);
+    return it->second->terrain[ChunkColumn::index(x - origin.x, z - origin.z)];
+}
+
+int32_t World::highest_block(const int32_t x, const int32_t z) const {
+    const auto chunk_id = chunk_id_from_world_coords({x, 0, z});
+    const auto it = columns.find(column_id(chunk_id));
+    if (it == columns.end()) return COLUMN_NO_BLOCK;
+
+    const auto origin = chunk_id_to_world_coordinates(chunk_id);
+    return it->second->highest[ChunkColumn::index(x - origin.x, z - origin.z)];
+}
+
+ChunkColumn &World::acquire_column(const ChunkId chunk_id) {
+    auto &column = columns[column_id(chunk_id)];
+    if (!column) {
+        // once per stack instead of once per generated chunk
+        column = column_pool.acquire();
+        const auto origin = chunk_id_to_world_coordinates(chunk_id);
+        generator.heightmap(origin.x, origin.z, column->terrain.data());
+    }
+    column->chunks++;
+    return *column;
+}
+
+void World::release_column(const ChunkId chunk_id) {
+    const auto it = columns.find(column_id(chunk_id));
+    ASSERT_DEBUG(it != columns.end(), "releasing a column that was never acquired");
+    if (--it->second->chunks > 0) return;
+    column_pool.release(it->second);
+    columns.erase(it);
+}
+
+void World::add_column_heights(const Chunk &chunk) {
+    auto &column = *columns.find(column_id(chunk.id))->second;
+    const auto [chunk_x, chunk_y, chunk_z] = chunk_id_to_chunk_coords(chunk.id);
+    const auto origin_y = chunk_y * CHUNK_SIZE_Y;
+    column.add_chunk_y(chunk_y);
+
+    if (chunk.blocks.is_uniform()) {
+        if (chunk.blocks.uniform_type() == BlockType::AIR) return;
+        for (auto &highest: column.highest)
+            highest = std::max(highest, origin_y + CHUNK_SIZE_Y - 1);
+        return;
+    }
+
+    std::array<BlockType, CHUNK_VOLUME> blocks;
+    chunk.blocks.unpack(blocks.data());
+    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (auto x = 0; x < CHUNK_SIZE_X; x++) {
+            auto &highest = column.highest[ChunkColumn::index(x, z)];
+            if (highest >= origin_y + CHUNK_SIZE_Y - 1) continue;
+            for (auto y = CHUNK_SIZE_Y - 1; y >= 0 && origin_y + y > highest; y--) {
+                if (blocks[Chunk::block_index(x, y, z)] == BlockType::AIR) continue;
+                highest = origin_y + y;
+                break;
+            }
+        }
+    }
+}
+
+void World::remove_column_heights(const Chunk &chunk) {
+    auto &column = *columns.find(column_id(chunk.id))->second;
+    const auto chunk_y = chunk_id_to_chunk_coords(chunk.id).y;
+    const auto origin_y = chunk_y * CHUNK_SIZE_Y;
+    column.remove_chunk_y(chunk_y);
+
+    // only block columns whose top was in this chunk change
+    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (auto x = 0; x < CHUNK_SIZE_X; x++) {
+            auto &highest = column.highest[ChunkColumn::index(x, z)];
+            if (highest >= origin_y && highest < origin_y + CHUNK_SIZE_Y)
+                highest = scan_column_height(column, chunk.id, x, z, origin_y);
+        }
+    }
+}
+
+int32_t World::scan_column_height(const ChunkColumn &column, const ChunkId column_chunk_id, const int32_t x,
+                                  const int32_t z, const int32_t below) const {
+    const auto [chunk_x, unused, chunk_z] = chunk_id_to_chunk_coords(column_chunk_id);
+    for (const auto chunk_y: column.chunk_ys) {
+        const auto origin_y = chunk_y * CHUNK_SIZE_Y;
+        if (origin_y >= below) continue;
+
+        const auto &chunk = getChunk(chunk_id_from_chunk_coords(chunk_x, chunk_y, chunk_z));
+        if (chunk.blocks.is_uniform()) {
+            if (chunk.blocks.uniform_type() == BlockType::AIR) continue;
+            return std::min(below - 1, origin_y + CHUNK_SIZE_Y - 1);
+        }
+        for (auto y = std::min(CHUNK_SIZE_Y - 1, below - 1 - origin_y); y >= 0; y--)
+            if (chunk.getBlock(x, y, z) != BlockType::AIR) return origin_y + y;
+    }
+    return COLUMN_NO_BLOCK;
+}
+
 bool World::loadChunk(ChunkId chunk_id) {
     if (isChunkLoaded(chunk_id)) return false;
 
-    chunks[chunk_id] = std::make_unique<Chunk>(chunk_id);
+    auto *chunk = chunks[chunk_id] = chunk_pool.acquire(chunk_id);
+    chunk->setState(ChunkState::LOADED);
+    acquire_column(chunk_id);
+
+    for (auto face = 0; face < CUBE_FACES; face++) {
+        const auto it = chunks.find(neighbor_chunk_id(chunk_id, face));
+        if (it == chunks.end()) continue;
+
+        // opposite faces are paired in directions[]
+        chunk->neighbors[face] = it->second;
+        it->second->neighbors[face ^ 1] = chunk;
+    }
+    return true;
+}
+
+bool World::request_chunk(const ChunkId chunk_id) {
+    if (isChunkLoaded(chunk_id) || requested_chunks.contains(chunk_id)) return false;
+
+    requested_chunks[chunk_id] = 1;
+    if (!newer_saves.contains(chunk_id) && snapshot.contains(chunk_id)) {
+        // answered like a read that found nothing, finish_chunk_loads maps it without a round trip through io
+        finished_reads.push_back({chunk_id, false, io.take_blocks()});
+        return true;
+    }
+    io.request_read(chunk_id);
     return true;
-}
\ No newline at end of file
+}
+
+void World::generate_chunk(Chunk &chunk) {
+    chunk.generating = true;
+    generating_chunks++;
+    auto *job = generation_jobs.acquire(&chunk);
+    job->heights = columns[column_id(chunk.id)]->terrain;
+    generation_pool.submit([this, job] {
+        auto *target = job->chunk;
+        std::array<BlockType, CHUNK_VOLUME> raw;
+        generator.terrain(target->id, job->heights.data(), raw.data());
+        target->setState(ChunkState::TERRAIN);
+        generator.carve(target->id, raw.data());
+        TerrainGenerator::surface(raw.data(), target->surface);
+        target->blocks.assign(raw.data());
+        target->has_surface = true;
+        target->setState(ChunkState::CARVED);
+
+        std::lock_guard lock(generated_mutex);
+        generated_jobs.push_back(job);
+    });
+}
+
+void World::try_decorate(const ChunkId chunk_id) {
+    const auto it = chunks.find(chunk_id);
+    if (it == chunks.end() || it->second->generating || it->second->getState() != ChunkState::CARVED) return;
+
+    const auto [chunk_x, chunk_y, chunk_z] = chunk_id_to_chunk_coords(chunk_id);
+    std::array<Chunk *, DECORATION_NEIGHBORHOOD> neighbors;
+    for (auto i = 0; i < DECORATION_NEIGHBORHOOD; i++) {
+        const auto *offset = Decorator::neighbor_offsets[i];
+        const auto neighbor = chunks.find(chunk_id_from_chunk_coords(chunk_x + offset[0], chunk_y + offset[1],
+                                                                     chunk_z + offset[2]));
+        if (neighbor == chunks.end() || !neighbor->second->reached(ChunkState::CARVED)) return;
+        neighbors[i] = neighbor->second;
+    }
+
+    auto &chunk = *it->second;
+    chunk.generating = true;
+    generating_chunks++;
+    // the neighbours' surfaces are copied now, the worker never touches another chunk
+    auto *job = generation_jobs.acquire(&chunk);
+    for (auto i = 0; i < DECORATION_NEIGHBORHOOD; i++) {
+        if (neighbors[i]->has_surface) job->surfaces[i] = neighbors[i]->surface;
+        else job->missing_surfaces[job->missing++] = static_cast<uint8_t>(i);
+    }
+    generation_pool.submit([this, job] {
+        auto *target = job->chunk;
+        // neighbours read from disk only have their decorated blocks, their surface is generated again
+        const auto [x, y, z] = chunk_id_to_chunk_coords(target->id);
+        for (size_t m = 0; m < job->missing; m++) {
+            const auto i = job->missing_surfaces[m];
+            const auto *offset = Decorator::neighbor_offsets[i];
+            generator.surface(chunk_id_from_chunk_coords(x + offset[0], y + offset[1], z + offset[2]),
+                              job->surfaces[i]);
+        }
+        decorator.decorate(target->id, job->surfaces.data(), target->blocks);
+        target->setState(ChunkState::INITIALIZED);
+
+        std::lock_guard lock(generated_mutex);
+        generated_jobs.push_back(job);
+    });
+}
+
+void World::decorate_dependents(const ChunkId chunk_id) {
+    const auto [chunk_x, chunk_y, chunk_z] = chunk_id_to_chunk_coords(chunk_id);
+    for (const auto *offset: Decorator::neighbor_offsets)
+        try_decorate(chunk_id_from_chunk_coords(chunk_x - offset[0], chunk_y - offset[1], chunk_z - offset[2]));
+}
+
+size_t World::finish_chunk_loads(std::vector<ChunkId> &loaded, const std::chrono::steady_clock::time_point deadline) {
+    size_t count = 0;
+
+    {
+        std::lock_guard lock(generated_mutex);
+        collected_jobs.swap(generated_jobs);
+    }
+    for (auto *job: collected_jobs) {
+        auto *chunk = job->chunk;
+        generation_jobs.release(job);
+        generating_chunks--;
+        chunk->generating = false;
+        const auto abandoned = std::find(abandoned_chunks.begin(), abandoned_chunks.end(), chunk);
+        if (abandoned != abandoned_chunks.end()) {
+            abandoned_chunks.erase(abandoned);
+            chunk_pool.release(chunk);
+            continue;
+        }
+
+        if (chunk->getState() == ChunkState::CARVED) {
+            // this chunk may have been the last one its neighbours (or itself) waited for
+            decorate_dependents(chunk->id);
+            continue;
+        }
+        add_column_heights(*chunk);
+        loaded.push_back(chunk->id);
+        count++;
+    }
+    collected_jobs.clear();
+
+    io.collect(finished_reads);
+
+    size_t done = 0;
+    while (done < finished_reads.size()) {
+        auto &read = finished_reads[done++];
+        // unloaded or requested again while the read was in flight
+        if (!requested_chunks.erase(read.chunk_id) || !loadChunk(read.chunk_id)) continue;
+
+        auto &chunk = getChunk(read.chunk_id);
+        // saved edits win over the snapshot
+        if (read.found) {
+            // the pooled chunk keeps its allocations, the old ones go back to io with the read below
+            chunk.blocks.swap(read.blocks);
+        } else if (!snapshot.map_chunk(chunk)) {
+            // never saved, generation gives the same blocks again so it is only saved once setBlock changes it
+            generate_chunk(chunk);
+            continue;
+        }
+        chunk.setState(ChunkState::INITIALIZED);
+        add_column_heights(chunk);
+        loaded.push_back(read.chunk_id);
+        count++;
+        decorate_dependents(read.chunk_id);
+
+        if (std::chrono::steady_clock::now() >= deadline) break;
+    }
+    for (size_t i = 0; i < done; i++)
+        io.recycle(std::move(finished_reads[i].blocks));
+    finished_reads.erase(finished_reads.begin(), finished_reads.begin() + static_cast<ptrdiff_t>(done));
+    return count;
+}
+
+bool World::unloadChunk(const ChunkId chunk_id) {
+    requested_chunks.erase(chunk_id);
+
+    const auto it = chunks.find(chunk_id);
+    if (it == chunks.end()) return false;
+
+    for (auto face = 0; face < CUBE_FACES; face++)
+        if (auto *neighbor = it->second->neighbors[face]) neighbor->neighbors[face ^ 1] = nullptr;
+
+    if (it->second->generating) {
+        // the generation worker may still write the blocks and still reports the chunk back, nothing to save yet
+        release_column(chunk_id);
+        abandoned_chunks.push_back(it->second);
+        chunks.erase(it);
+        return true;
+    }
+
+    // waiting for its neighbours to decorate, it is generated again next time
+    if (!it->second->isInitialized()) {
+        release_column(chunk_id);
+        chunk_pool.release(it->second);
+        chunks.erase(it);
+        return true;
+    }
+
+    if (it->second->dirty) save_chunk(*it->second);
+
+    remove_column_heights(*it->second);
+    release_column(chunk_id);
+    chunk_pool.release(it->second);
+    chunks.erase(it);
+    return true;
+}
+
+size_t World::save_dirty_chunks() {
+    size_t saved = 0;
+    for (auto &[chunk_id, chunk]: chunks) {
+        if (!chunk->dirty || !chunk->isInitialized()) continue;
+        save_chunk(*chunk);
+        chunk->dirty = false;
+        saved++;
+    }
+    return saved;
+}
+
+void World::save_chunk(const Chunk &chunk) {
+    io.request_save(chunk);
+    newer_saves[chunk.id] = 1;
+}
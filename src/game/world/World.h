@@ -4,14 +4,27 @@
 
 #ifndef MINECRAFT_WORLD_H
 #define MINECRAFT_WORLD_H
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
 #include <map>
-#include <unordered_map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "chunks/Chunk.h"
+#include "chunks/ChunkColumn.h"
+#include "chunks/ChunkPool.h"
+#include "generation/Decorator.h"
+#include "generation/GenerationJob.h"
+#include "generation/TerrainGenerator.h"
+#include "storage/ChunkIO.h"
+#include "storage/WorldSnapshot.h"
 #include "glm/vec3.hpp"
 #include "../players/Player.h"
+#include "../../utils/FlatHashMap.h"
+#include "../../utils/ThreadPool.h"
 
 
 struct WorldCoord {
@@ -23,10 +36,63 @@ struct World {
     glm::vec3 spawn_point;
     std::vector<std::shared_ptr<Player> > players;
 
-    std::unordered_map<ChunkId, std::unique_ptr<Chunk> > chunks{};
-
-    World(const uint8_t id, const glm::vec3 &spawn_point) : id(id), spawn_point(spawn_point) {
+    // declared before the chunks so that it outlives the chunks mapped from it
+    WorldSnapshot snapshot{};
+    ChunkPool chunk_pool{};
+    // owned by chunk_pool
+    FlatHashMap<ChunkId, Chunk *> chunks{};
+    ChunkColumnPool column_pool{};
+    // heights of every chunk stack with a loaded chunk, keyed by column_id, owned by column_pool
+    FlatHashMap<ChunkId, ChunkColumn *> columns{};
+    // chunks requested from io and not loaded yet
+    FlatHashMap<ChunkId, uint8_t> requested_chunks{};
+    // chunks saved to the region files since the snapshot was baked, only these are read instead of mapped
+    FlatHashMap<ChunkId, uint8_t> newer_saves{};
+    std::vector<ChunkReadResult> finished_reads{};
+    TerrainGenerator generator{WORLD_SEED};
+    Decorator decorator{WORLD_SEED};
+    ChunkIO io;
+
+    GenerationJobPool generation_jobs{};
+    std::mutex generated_mutex;
+    // filled by the generation workers, collected by finish_chunk_loads which gives the jobs back to generation_jobs
+    std::vector<GenerationJob *> generated_jobs{};
+    // swapped with generated_jobs, so that neither loses its capacity
+    std::vector<GenerationJob *> collected_jobs{};
+    // generating chunks that were unloaded meanwhile, they go back to the pool once their worker is done
+    std::vector<Chunk *> abandoned_chunks{};
+    size_t generating_chunks = 0;
+    // Chunks without a saved or mapped copy are generated here. Their slot is reserved in chunks on the main thread
+    // (state LOADED, linked to its neighbours), one job runs the terrain and carve stages (CARVED) and a second one
+    // decorates once the whole decoration neighbourhood is carved. The chunk only becomes readable at INITIALIZED.
+    // Declared last so the workers are joined before anything they use goes away.
+    ThreadPool generation_pool{generation_threads()};
+
+    World(const uint8_t id, const glm::vec3 &spawn_point)
+        : id(id), spawn_point(spawn_point), io(save_directory(id)) {
+        if (snapshot.open(save_directory(id) / WORLD_SNAPSHOT_FILE)) {
+            std::vector<ChunkId> saved;
+            io.saved_since(snapshot.baked_at(), saved);
+            for (const auto chunk_id: saved)
+                newer_saves[chunk_id] = 1;
+            PRINT_DEBUG("mapped world snapshot with " << snapshot.chunk_count() << " chunks, " << saved.size()
+                << " saved since");
+        }
+        // load the spawn area around the ground instead of wherever WORLD_SPAWN_COORDS put it
+        this->spawn_point.y = static_cast<float>(terrain_height(static_cast<int32_t>(std::floor(spawn_point.x)),
+                                                                static_cast<int32_t>(std::floor(spawn_point.z))));
         generate_chunks();
+        place_spawn();
+    }
+
+    World(const World &) = delete;
+
+    World &operator=(const World &) = delete;
+
+    // io writes the last saves before it is destroyed
+    ~World() {
+        generation_pool.wait_idle();
+        save_dirty_chunks();
     }
 
     void add_player(const std::shared_ptr<Player> &player) {
@@ -38,108 +104,83 @@ struct World {
     }
 
     void generate_chunks() {
-        const glm::vec3 spawn_coords = WORLD_SPAWN_COORDS;
-        const auto world_min_boundary = spawn_coords - static_cast<float>(WORLD_SPAWN_RENDER_CHUNKS);
-        const auto world_max_boundary = spawn_coords + static_cast<float>(WORLD_SPAWN_RENDER_CHUNKS);
+        const auto world_min_boundary = spawn_point - static_cast<float>(WORLD_SPAWN_RENDER_CHUNKS);
+        const auto world_max_boundary = spawn_point + static_cast<float>(WORLD_SPAWN_RENDER_CHUNKS);
 
-        const auto minX = std::max(static_cast<int>(world_min_boundary.x), 0);
-        const auto minY = std::max(static_cast<int>(world_min_boundary.y), 0);
-        const auto minZ = std::max(static_cast<int>(world_min_boundary.z), 0);
+        // one more chunk around (and below) the area so that every chunk inside it has its decoration neighbours,
+        // the extra ones stay carved until streaming loads their own neighbours
+        const auto minX = static_cast<int>(world_min_boundary.x) - CHUNK_SIZE_X;
+        const auto minY = static_cast<int>(world_min_boundary.y) - CHUNK_SIZE_Y;
+        const auto minZ = static_cast<int>(world_min_boundary.z) - CHUNK_SIZE_Z;
 
-        const auto maxX = static_cast<int>(world_max_boundary.x);
+        const auto maxX = static_cast<int>(world_max_boundary.x) + CHUNK_SIZE_X;
         const auto maxY = static_cast<int>(world_max_boundary.y);
-        const auto maxZ = static_cast<int>(world_max_boundary.z);
+        const auto maxZ = static_cast<int>(world_max_boundary.z) + CHUNK_SIZE_Z;
 
         for (auto y = minY; y < maxY; y += CHUNK_SIZE_Y) {
             for (auto x = minX; x < maxX; x += CHUNK_SIZE_X) {
                 for (auto z = minZ; z < maxZ; z += CHUNK_SIZE_Z) {
                     const auto chunk_id = World::chunk_id_from_world_coords({x, y, z});
-                    auto chunkLoaded = loadChunk(chunk_id);
-                    ASSERT_DEBUG(chunkLoaded, "failed loading chunk");
-                    if (!chunkLoaded) continue;
-
-                    auto [world_x, world_y, world_z] = World::chunk_id_to_world_coordinates(chunk_id);
-                    PRINT_DEBUG(
-                        "loaded chunk=" << chunk_id <<" at x=" << x << " y=" << y << " z=" << z << " (" << world_x << ", "
-                        << world_y << ", " << world_z<<")");
-                    WHEN_DEBUG(std::cout << std::flush);
-
-                    auto &chunk = getChunk(chunk_id);
-                    chunk.setIndex(chunk_id);
-                    chunk.initializeBlocks();
+                    auto chunkRequested = request_chunk(chunk_id);
+                    ASSERT_DEBUG(chunkRequested, "failed loading chunk");
                 }
             }
         }
+
+        // the spawn area has to be there for the first frame
+        const auto start = std::chrono::steady_clock::now();
+        io.wait_idle();
+        std::vector<ChunkId> loaded;
+        finish_chunk_loads(loaded, std::chrono::steady_clock::time_point::max());
+        // collecting carved chunks hands out decorations, so wait until nothing is left in flight
+        while (generating_chunks > 0) {
+            generation_pool.wait_idle();
+            finish_chunk_loads(loaded, std::chrono::steady_clock::time_point::max());
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        PRINT_DEBUG("loaded " << loaded.size() << " spawn chunks in " << elapsed * 1000.0 << "ms on "
+            << generation_pool.size() << " generation threads");
+        for (const auto chunk_id: loaded) {
+            auto [world_x, world_y, world_z] = World::chunk_id_to_world_coordinates(chunk_id);
+            PRINT_DEBUG("loaded chunk=" << chunk_id << " at (" << world_x << ", " << world_y << ", " << world_z << ")");
+        }
+        WHEN_DEBUG(std::cout << std::flush);
     }
 
-    std::vector<float> generate_visible_vertices() {
-        std::vector<float> visibleVertices;
-        visibleVertices.reserve(WORLD_RENDER_VERTICES_RESERVE);
+    // puts the spawn point on top of the highest block of its column
+    void place_spawn() {
+        const auto x = static_cast<int32_t>(std::floor(spawn_point.x));
+        const auto z = static_cast<int32_t>(std::floor(spawn_point.z));
+        auto ground = highest_block(x, z);
+        if (ground == COLUMN_NO_BLOCK) ground = terrain_height(x, z);
+        spawn_point.y = static_cast<float>(ground + 1) + WORLD_SPAWN_EYE_HEIGHT;
+    }
 
-        ASSERT_DEBUG(chunks.size()>0, "invalid world chunks");
-        for (auto &[chunk_index, chunk]: chunks) {
-            const auto [chunk_x, chunk_y, chunk_z] = chunk_id_to_world_coordinates(chunk_index);
+    // asks io for the saved copy of the chunk, or takes it straight from the snapshot when no newer save exists. False
+    // when it is already loaded or requested
+    bool request_chunk(ChunkId chunk_id);
 
-            // chunk coordinate system tests
-            {
-                WHEN_DEBUG(const auto chunk_id = chunk_id_from_world_coords({chunk_x, chunk_y, chunk_z}));
-                ASSERT_DEBUG(chunk_index == chunk_id, "Mismatch chunking id => coordinates");
-            }
-            //
-
-            for (auto y = 0; y < CHUNK_SIZE_Y; y++) {
-                for (auto x = 0; x < CHUNK_SIZE_X; x++) {
-                    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
-                        auto index = Chunk::block_index(x, y, z);
-                        if (auto &block = chunk->blocks[index]; block.block_type() == BlockType::AIR) continue;
-
-                        for (auto face = 0; face < 6; ++face) {
-                            auto nx = x + directions[face][0];
-                            auto ny = y + directions[face][1];
-                            auto nz = z + directions[face][2];
-
-                            auto neighborIsSolid = false;
-                            const auto world_position_current_block = glm::vec3(chunk_x + x, chunk_y + y, chunk_z + z);
-                            if (nx >= 0 && nx < CHUNK_SIZE_X &&
-                                ny >= 0 && ny < CHUNK_SIZE_Y &&
-                                nz >= 0 && nz < CHUNK_SIZE_Z) {
-                                auto neighbor_block_index = Chunk::block_index(nx, ny, nz);
-                                neighborIsSolid = chunk->blocks[neighbor_block_index].block_type() != BlockType::AIR;
-                            } else {
-                                auto neighbor_x = x + directions[face][0];
-                                auto neighbor_y = y + directions[face][1];
-                                auto neighbor_z = z + directions[face][2];
-                                auto neighbor_chunk_id = chunk_id_from_world_coords(
-                                    {chunk_x + neighbor_x, chunk_y + neighbor_y, chunk_z + neighbor_z}
-                                );
-
-                                if (auto it = chunks.find(neighbor_chunk_id); it != chunks.end()) {
-                                    auto &neighbor_chunk = it->second;
-                                    auto neighbor_block_x = (neighbor_x + CHUNK_SIZE_X) % CHUNK_SIZE_X;
-                                    auto neighbor_block_y = (neighbor_y + CHUNK_SIZE_Y) % CHUNK_SIZE_Y;
-                                    auto neighbor_block_z = (neighbor_z + CHUNK_SIZE_Z) % CHUNK_SIZE_Z;
-                                    auto neighbor_index = Chunk::block_index(
-                                        neighbor_block_x, neighbor_block_y, neighbor_block_z);
-                                    neighborIsSolid =
-                                            neighbor_chunk->blocks[neighbor_index].block_type() != BlockType::AIR;
-                                }
-                            }
-
-                            if (neighborIsSolid) continue;
-                            for (int i = 0; i < 30; i += 5) {
-                                auto vx = faceVertices[face][i] + world_position_current_block.x;
-                                auto vy = faceVertices[face][i + 1] + world_position_current_block.y;
-                                auto vz = faceVertices[face][i + 2] + world_position_current_block.z;
-                                auto u = faceVertices[face][i + 3];
-                                auto v = faceVertices[face][i + 4];
-                                visibleVertices.insert(visibleVertices.end(), {vx, vy, vz, u, v});
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        return visibleVertices;
+    // loads the chunks whose reads finished, from their saved copy or the snapshot, and hands the others to the
+    // generation pool. Collects finished generation stages and starts the decorations they unblocked. Chunks that
+    // became INITIALIZED are appended to loaded. Stops after the read that passes deadline, the rest waits for the
+    // next call.
+    size_t finish_chunk_loads(std::vector<ChunkId> &loaded, std::chrono::steady_clock::time_point deadline);
+
+    [[nodiscard]] size_t pending_chunk_loads() const { return requested_chunks.size() + generating_chunks; }
+
+    // generation_pool's part of ThreadPool::thread_budget(), the mesh builder of Render takes the rest
+    static size_t generation_threads() {
+        const auto share = static_cast<double>(ThreadPool::thread_budget()) * WORLD_GENERATION_THREAD_SHARE;
+        return std::max<size_t>(static_cast<size_t>(share), 1);
+    }
+
+    static std::filesystem::path save_directory(const uint8_t world_id) {
+        return std::filesystem::path(WORLD_SAVE_DIRECTORY) / std::to_string(world_id);
+    }
+
+    // writes every loaded chunk to the snapshot file, it is mapped from the next start on
+    bool bake_snapshot() const {
+        return WorldSnapshot::bake(*this, save_directory(id) / WORLD_SNAPSHOT_FILE);
     }
 
     static uint32_t generate_entity_id() {
@@ -147,34 +188,110 @@ struct World {
         return ++id;
     }
 
-    static constexpr ChunkId chunk_id_from_world_coords(const WorldCoord coord) {
-        const auto chunkX = coord.x / CHUNK_SIZE_X;
-        const auto chunkY = coord.y / CHUNK_SIZE_Y;
-        const auto chunkZ = coord.z / CHUNK_SIZE_Z;
+    // rounds towards negative infinity so that block -1 lands in chunk -1
+    static constexpr int32_t floor_div(const int32_t value, const int32_t divisor) {
+        return (value >= 0 ? value : value - divisor + 1) / divisor;
+    }
 
-        return chunkX + (WORLD_SIZE_X * chunkY) + (WORLD_SIZE_X * WORLD_SIZE_Y * chunkZ);
+    static constexpr ChunkId chunk_id_from_chunk_coords(const int32_t x, const int32_t y, const int32_t z) {
+        constexpr auto mask = (uint64_t{1} << CHUNK_ID_AXIS_BITS) - 1;
+        return (static_cast<uint64_t>(x) & mask)
+               | (static_cast<uint64_t>(y) & mask) << CHUNK_ID_AXIS_BITS
+               | (static_cast<uint64_t>(z) & mask) << CHUNK_ID_AXIS_BITS * 2;
     }
 
-    static constexpr WorldCoord chunk_id_to_world_coordinates(const ChunkId id) {
-        const auto chunkZ = id / (WORLD_SIZE_X * WORLD_SIZE_Y);
-        const auto remaining = id % (WORLD_SIZE_X * WORLD_SIZE_Y);
-        const auto chunkY = remaining / WORLD_SIZE_X;
-        const auto chunkX = remaining % WORLD_SIZE_X;
+    static constexpr WorldCoord chunk_id_to_chunk_coords(const ChunkId id) {
+        // move each field to the top bits and shift back arithmetically to restore the sign
+        constexpr auto unused = 64 - CHUNK_ID_AXIS_BITS;
+        return {
+            static_cast<int32_t>(static_cast<int64_t>(id << unused) >> unused),
+            static_cast<int32_t>(static_cast<int64_t>(id << (unused - CHUNK_ID_AXIS_BITS)) >> unused),
+            static_cast<int32_t>(static_cast<int64_t>(id << (unused - CHUNK_ID_AXIS_BITS * 2)) >> unused)
+        };
+    }
 
+    static constexpr ChunkId chunk_id_from_world_coords(const WorldCoord coord) {
+        return chunk_id_from_chunk_coords(floor_div(coord.x, CHUNK_SIZE_X), floor_div(coord.y, CHUNK_SIZE_Y),
+                                          floor_div(coord.z, CHUNK_SIZE_Z));
+    }
+
+    static constexpr WorldCoord chunk_id_to_world_coordinates(const ChunkId id) {
+        const auto [chunkX, chunkY, chunkZ] = chunk_id_to_chunk_coords(id);
         return {chunkX * CHUNK_SIZE_X, chunkY * CHUNK_SIZE_Y, chunkZ * CHUNK_SIZE_Z};
     }
 
+    // the stack of chunks the chunk belongs to, its id with the y field cleared
+    static constexpr ChunkId column_id(const ChunkId chunk_id) {
+        constexpr auto y_mask = ((uint64_t{1} << CHUNK_ID_AXIS_BITS) - 1) << CHUNK_ID_AXIS_BITS;
+        return chunk_id & ~y_mask;
+    }
+
+    static constexpr ChunkId neighbor_chunk_id(const ChunkId chunk_id, const int face) {
+        const auto [x, y, z] = chunk_id_to_chunk_coords(chunk_id);
+        return chunk_id_from_chunk_coords(x + directions[face][0], y + directions[face][1], z + directions[face][2]);
+    }
+
     [[nodiscard]] Chunk &getChunk(WorldCoord coords);
 
     [[nodiscard]] Chunk &getChunk(ChunkId chunk_id);
 
-    [[nodiscard]] bool isChunkLoaded(ChunkId chunk_id);
+    [[nodiscard]] const Chunk &getChunk(ChunkId chunk_id) const;
+
+    // true for reserved chunks too, whose blocks may still be generating
+    [[nodiscard]] bool isChunkLoaded(ChunkId chunk_id) const;
+
+    // loaded and its blocks can be read
+    [[nodiscard]] bool isChunkInitialized(ChunkId chunk_id) const;
+
+    // AIR outside initialized chunks
+    [[nodiscard]] BlockType getBlock(WorldCoord coords) const;
+
+    // changes one block of an initialized chunk and keeps the column heights in step, false when there is none
+    bool setBlock(WorldCoord coords, BlockType type);
+
+    // generator surface height of the block column, a lookup while a chunk of its stack is loaded
+    [[nodiscard]] int32_t terrain_height(int32_t x, int32_t z) const;
+
+    // highest non air block of the block column over the initialized chunks, COLUMN_NO_BLOCK when there is none
+    [[nodiscard]] int32_t highest_block(int32_t x, int32_t z) const;
 
+    // bytes held by the block storage of every initialized chunk
+    [[nodiscard]] size_t chunk_memory_usage() const;
+
+    // links an empty chunk (state LOADED) into the world, its blocks come from finish_chunk_loads
     bool loadChunk(ChunkId chunk_id);
 
-    static constexpr bool isOutOfBounds(const int x, const int y, const int z) {
-        return x >= WORLD_SIZE_X || y >= WORLD_SIZE_Y || z >= WORLD_SIZE_Z || x < 0 || y < 0 || z < 0;
-    }
+    // queues a save of every loaded dirty chunk, returns how many were queued
+    size_t save_dirty_chunks();
+
+    // queues the save and remembers that the region copy is now newer than the snapshot
+    void save_chunk(const Chunk &chunk);
+
+    // first job of a reserved chunk: terrain and carve stages
+    void generate_chunk(Chunk &chunk);
+
+    // starts the decoration of a carved chunk once its whole neighbourhood is carved
+    void try_decorate(ChunkId chunk_id);
+
+    // try_decorate on every chunk whose decoration neighbourhood contains chunk_id
+    void decorate_dependents(ChunkId chunk_id);
+
+    // column bookkeeping, acquire/release count reserved chunks and add/remove the heights of initialized ones
+    ChunkColumn &acquire_column(ChunkId chunk_id);
+
+    void release_column(ChunkId chunk_id);
+
+    void add_column_heights(const Chunk &chunk);
+
+    void remove_column_heights(const Chunk &chunk);
+
+    // highest non air block of the block column x, z (chunk local) strictly below world height below
+    [[nodiscard]] int32_t scan_column_height(const ChunkColumn &column, ChunkId column_chunk_id, int32_t x, int32_t z,
+                                             int32_t below) const;
+
+    // queues a save first when the chunk is dirty, also drops a pending request of it. A chunk that is still generating
+    // leaves the world right away but is released to the pool only after its worker finished.
+    bool unloadChunk(ChunkId chunk_id);
 };
 
 
@@ -7,77 +7,118 @@
 
 #include <glad/glad.h>
 
-#define WORLD_SIZE_X 64
-#define WORLD_SIZE_Y 64
-#define WORLD_SIZE_Z 64
-
 #define CHUNK_SIZE_X 16
 #define CHUNK_SIZE_Y 16
 #define CHUNK_SIZE_Z 16
+#define CHUNK_VOLUME (CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z)
+#define CHUNK_POOL_SLAB_CHUNKS 64
+#define CHUNK_COLUMN_POOL_SLAB_COLUMNS 16
+#define GENERATION_JOB_POOL_SLAB_JOBS 16
+// bits per signed chunk coordinate packed into a ChunkId, +-2^20 chunks on every axis
+#define CHUNK_ID_AXIS_BITS 21
 
 #define WORLD_SPAWN_COORDS glm::vec3(1000, 100, 1000)
 #define WORLD_SPAWN_RENDER_CHUNKS 16
-#define WORLD_RENDER_VERTICES_RESERVE 300000
+// the spawn y is replaced by the ground height plus this
+#define WORLD_SPAWN_EYE_HEIGHT 1.6f
+#define WORLD_MESHING_MODE MeshingMode::GREEDY
+
+#define WORLD_SEED 1337u
+// surface heights are TERRAIN_BASE_HEIGHT +- TERRAIN_AMPLITUDE blocks, hills are about TERRAIN_SCALE blocks wide
+#define TERRAIN_BASE_HEIGHT 64
+#define TERRAIN_AMPLITUDE 32
+#define TERRAIN_SCALE 128.0f
+#define TERRAIN_OCTAVES 5
+#define TERRAIN_DIRT_DEPTH 3
+// caves are carved where two 3D noise fields are both close to 0, which leaves long winding tunnels
+#define CAVE_SCALE 40.0f
+#define CAVE_THRESHOLD 0.08f
+// the fields are sampled every CAVE_LATTICE_SPACING blocks and interpolated in between
+#define CAVE_LATTICE_SPACING 4
+// nothing at or above this world height is carved
+#define CAVE_MAX_HEIGHT TERRAIN_BASE_HEIGHT
+// tree spots rolled per chunk, a spot grows a tree when it lands on a surface grass block and a second roll passes
+#define DECORATION_TREE_ATTEMPTS 6
+#define DECORATION_TREE_MIN_TRUNK 4
+#define DECORATION_ORE_ATTEMPTS 8
+// coal veins only start below this world height
+#define DECORATION_ORE_MAX_HEIGHT 56
+
+// in chunks, a chunk unloads only once it is further than CHUNK_STREAM_UNLOAD_RADIUS from every player
+#define CHUNK_STREAM_LOAD_RADIUS 8
+#define CHUNK_STREAM_UNLOAD_RADIUS 10
+#define CHUNK_STREAM_BUDGET_MS 2.0
+// chunk reads in flight on the io thread
+#define CHUNK_STREAM_MAX_REQUESTS 64
+// the streaming queues are rebuilt once the camera turned further than this (cos ~37 degrees)
+#define CHUNK_STREAM_TURN_COSINE 0.8f
+#define CHUNK_MESH_UPLOAD_BUDGET_MS 2.0
+// share of ThreadPool::thread_budget() that generates chunks, the mesh builder gets the rest
+#define WORLD_GENERATION_THREAD_SHARE 0.5
 
+// saves live in WORLD_SAVE_DIRECTORY/<world id>/, one region file per REGION_SIZE^3 chunks
+#define WORLD_SAVE_DIRECTORY "world"
+#define REGION_SIZE 16
+#define REGION_CHUNKS (REGION_SIZE * REGION_SIZE * REGION_SIZE)
+#define REGION_SECTOR_SIZE 4096
+// LZ stores terrain in roughly half the bytes of PALETTE, see the chunk codec benchmark
+#define WORLD_STORAGE_CODEC ChunkCodecId::LZ
+// baked read only copy of a world, mapped instead of read, see WorldSnapshot
+#define WORLD_SNAPSHOT_FILE "world.snapshot"
+// appended to WORLD_SNAPSHOT_FILE for a bake that is switched to on the next start
+#define WORLD_SNAPSHOT_NEXT_SUFFIX ".next"
+#define WORLD_SNAPSHOT_PAGE_SIZE 4096
 
-const float faceVertices[6][30] = {
+
+// corners of each face, drawn as two triangles through quadIndices
+const float faceVertices[6][20] = {
     // front face (z+) - posição + tex coords
     {
         -0.5f, -0.5f, 0.5f, 0.0f, 0.0f,
         0.5f, -0.5f, 0.5f, 1.0f, 0.0f,
         0.5f, 0.5f, 0.5f, 1.0f, 1.0f,
-        0.5f, 0.5f, 0.5f, 1.0f, 1.0f,
-        -0.5f, 0.5f, 0.5f, 0.0f, 1.0f,
-        -0.5f, -0.5f, 0.5f, 0.0f, 0.0f
+        -0.5f, 0.5f, 0.5f, 0.0f, 1.0f
     },
     // back face (z-)
     {
         -0.5f, -0.5f, -0.5f, 0.0f, 0.0f,
         -0.5f, 0.5f, -0.5f, 0.0f, 1.0f,
         0.5f, 0.5f, -0.5f, 1.0f, 1.0f,
-        0.5f, 0.5f, -0.5f, 1.0f, 1.0f,
-        0.5f, -0.5f, -0.5f, 1.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f, 0.0f, 0.0f
+        0.5f, -0.5f, -0.5f, 1.0f, 0.0f
     },
     // left face (x-)
     {
         -0.5f, 0.5f, 0.5f, 0.0f, 1.0f,
         -0.5f, 0.5f, -0.5f, 1.0f, 1.0f,
         -0.5f, -0.5f, -0.5f, 1.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f, 1.0f, 0.0f,
-        -0.5f, -0.5f, 0.5f, 0.0f, 0.0f,
-        -0.5f, 0.5f, 0.5f, 0.0f, 1.0f
+        -0.5f, -0.5f, 0.5f, 0.0f, 0.0f
     },
     // right face (x+)
     {
         0.5f, 0.5f, 0.5f, 0.0f, 1.0f,
         0.5f, -0.5f, 0.5f, 0.0f, 0.0f,
         0.5f, -0.5f, -0.5f, 1.0f, 0.0f,
-        0.5f, -0.5f, -0.5f, 1.0f, 0.0f,
-        0.5f, 0.5f, -0.5f, 1.0f, 1.0f,
-        0.5f, 0.5f, 0.5f, 0.0f, 1.0f
+        0.5f, 0.5f, -0.5f, 1.0f, 1.0f
     },
     // top face (y+)
     {
         -0.5f, 0.5f, -0.5f, 0.0f, 0.0f,
         -0.5f, 0.5f, 0.5f, 0.0f, 1.0f,
         0.5f, 0.5f, 0.5f, 1.0f, 1.0f,
-        0.5f, 0.5f, 0.5f, 1.0f, 1.0f,
-        0.5f, 0.5f, -0.5f, 1.0f, 0.0f,
-        -0.5f, 0.5f, -0.5f, 0.0f, 0.0f
+        0.5f, 0.5f, -0.5f, 1.0f, 0.0f
     },
     // bottom face (y-)
     {
         -0.5f, -0.5f, -0.5f, 0.0f, 0.0f,
         0.5f, -0.5f, -0.5f, 1.0f, 0.0f,
         0.5f, -0.5f, 0.5f, 1.0f, 1.0f,
-        0.5f, -0.5f, 0.5f, 1.0f, 1.0f,
-        -0.5f, -0.5f, 0.5f, 0.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f, 0.0f, 0.0f
+        -0.5f, -0.5f, 0.5f, 0.0f, 1.0f
     }
 };
 
-const int directions[6][3] = {
+const uint16_t quadIndices[6] = {0, 1, 2, 2, 3, 0};
+
+constexpr int directions[6][3] = {
     {0, 0, 1}, // front
     {0, 0, -1}, // back
     {-1, 0, 0}, // left
@@ -86,11 +127,26 @@ const int directions[6][3] = {
     {0, -1, 0} // bottom
 };
 
+// axes followed by the u and v texture coordinates of each face in faceVertices
+const int faceTextureAxes[6][2] = {
+    {0, 1}, // front
+    {0, 1}, // back
+    {2, 1}, // left
+    {2, 1}, // right
+    {0, 2}, // top
+    {0, 2} // bottom
+};
+
 #define CUBE_FACES 6
+#define QUAD_VERTICES 4
+#define QUAD_INDICES 6
+
+// upper bound of exposed faces in a chunk (checkerboard pattern plus every border face)
+#define CHUNK_MAX_QUADS (CHUNK_VOLUME * CUBE_FACES / 2 + \
+2 * (CHUNK_SIZE_X * CHUNK_SIZE_Y + CHUNK_SIZE_Y * CHUNK_SIZE_Z + CHUNK_SIZE_X * CHUNK_SIZE_Z))
 
-#define WORLD_MAX_VERTICES (long long)((long long)(WORLD_SIZE_X * WORLD_SIZE_Y * WORLD_SIZE_Z) * \
-(long long)(CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z) * \
-CUBE_FACES * 30l)
+// vertices of a chunk meshed without any face culling
+#define CHUNK_UNCULLED_VERTICES (CHUNK_VOLUME * CUBE_FACES * QUAD_VERTICES)
 
 #define OVERWORLD 0
 
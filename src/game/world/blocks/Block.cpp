@@ -23,13 +23,13 @@ BlockType Block::block_type() const {
 }
 
 uint8_t Block::x() const {
-    return this->i % WORLD_SIZE_X;
+    return this->i % CHUNK_SIZE_X;
 }
 
 uint8_t Block::y() const {
-    return (this->i / WORLD_SIZE_X) % WORLD_SIZE_Y;
+    return (this->i / CHUNK_SIZE_X) % CHUNK_SIZE_Y;
 }
 
 uint8_t Block::z() const {
-    return this->i / (WORLD_SIZE_X * WORLD_SIZE_Y);
+    return this->i / (CHUNK_SIZE_X * CHUNK_SIZE_Y);
 }
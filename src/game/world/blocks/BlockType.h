@@ -4,11 +4,25 @@
 
 #ifndef MINECRAFT_BLOCKTYPE_H
 #define MINECRAFT_BLOCKTYPE_H
+#include <cstdint>
 
 enum class BlockType: uint8_t {
     AIR = 0,
     GRASS,
     DIRT,
+    STONE,
+    LOG,
+    LEAVES,
+    COAL_ORE,
 };
 
+// number of block types, keep it pointing past the last one
+constexpr uint32_t BLOCK_TYPE_COUNT = static_cast<uint32_t>(BlockType::COAL_ORE) + 1;
+static_assert(BLOCK_TYPE_COUNT == 7, "update blockTints in shader.frag");
+
+// bytes read from disk have to pass this before they are used as a BlockType
+constexpr bool is_block_type(const uint8_t value) {
+    return value < BLOCK_TYPE_COUNT;
+}
+
 #endif //MINECRAFT_BLOCKTYPE_H
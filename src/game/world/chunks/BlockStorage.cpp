@@ -0,0 +1,199 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "BlockStorage.h"
+
+#include <algorithm>
+#include <array>
+
+#include "../../../utils/Assert.h"
+#include "../../../utils/Bytes.h"
+
+uint32_t BlockStorage::read_index(const uint32_t index) const {
+    const auto bit = index * bits;
+    const auto mask = (uint64_t{1} << bits) - 1;
+    return static_cast<uint32_t>(word_data()[bit >> 6] >> (bit & 63) & mask);
+}
+
+void BlockStorage::write_index(const uint32_t index, const uint32_t palette_index) {
+    const auto bit = index * bits;
+    const auto mask = (uint64_t{1} << bits) - 1;
+    auto &word = words[bit >> 6];
+    word = (word & ~(mask << (bit & 63))) | (static_cast<uint64_t>(palette_index) << (bit & 63));
+}
+
+void BlockStorage::reserve_max() {
+    palette.reserve(size_t{1} << MAX_BITS);
+    words.reserve(words_for(MAX_BITS));
+}
+
+void BlockStorage::widen() {
+    ASSERT(bits < 8, "block palette cannot hold more than 256 types");
+
+    reserve_max();
+    if (bits == 0) {
+        // every block is palette[0], which is index 0
+        bits = 1;
+        words.assign(words_for(bits), 0);
+        return;
+    }
+
+    // repacked in place from the last index down: index i moves from bit i * bits to i * 2 * bits, so it never lands
+    // on an index that was not moved yet
+    const auto old_bits = bits;
+    const auto old_mask = (uint64_t{1} << old_bits) - 1;
+    bits *= 2;
+    words.resize(words_for(bits), 0);
+    for (uint32_t i = CHUNK_VOLUME; i-- > 0;) {
+        const auto bit = i * old_bits;
+        write_index(i, static_cast<uint32_t>(words[bit >> 6] >> (bit & 63) & old_mask));
+    }
+}
+
+void BlockStorage::set(const uint32_t index, const BlockType type) {
+    ASSERT_DEBUG(index < CHUNK_VOLUME, "block index out of chunk");
+
+    if (bits == 0 && palette[0] == type) return;
+    if (mapped_words != nullptr) detach();
+
+    uint32_t palette_index = 0;
+    while (palette_index < palette.size() && palette[palette_index] != type) palette_index++;
+
+    if (palette_index == palette.size()) {
+        if (palette.size() == size_t{1} << bits) widen();
+        palette.push_back(type);
+    }
+
+    write_index(index, palette_index);
+}
+
+void BlockStorage::fill(const BlockType type) {
+    palette.assign(1, type);
+    bits = 0;
+    mapped_words = nullptr;
+    std::vector<uint64_t>().swap(words);
+}
+
+void BlockStorage::assign(const BlockType *blocks) {
+    // palette index of every type, 0xFFFF for types not seen yet
+    std::array<uint16_t, 256> lookup;
+    lookup.fill(0xFFFF);
+    palette.reserve(size_t{1} << MAX_BITS);
+    palette.clear();
+    for (uint32_t i = 0; i < CHUNK_VOLUME; i++) {
+        auto &slot = lookup[static_cast<uint8_t>(blocks[i])];
+        if (slot != 0xFFFF) continue;
+        slot = static_cast<uint16_t>(palette.size());
+        palette.push_back(blocks[i]);
+    }
+
+    mapped_words = nullptr;
+    if (palette.size() == 1) {
+        bits = 0;
+        words.clear();
+        return;
+    }
+
+    bits = 1;
+    while (palette.size() > size_t{1} << bits) bits *= 2;
+    reserve_max();
+    // whole words at a time instead of a read-modify-write per block
+    words.resize(words_for(bits));
+    const uint32_t per_word = 64 / bits;
+    for (uint32_t w = 0, i = 0; w < words.size(); w++) {
+        uint64_t word = 0;
+        for (uint32_t j = 0; j < per_word; j++, i++)
+            word |= static_cast<uint64_t>(lookup[static_cast<uint8_t>(blocks[i])]) << (j * bits);
+        words[w] = word;
+    }
+}
+
+void BlockStorage::reset() {
+    palette.assign(1, BlockType::AIR);
+    bits = 0;
+    mapped_words = nullptr;
+    words.clear();
+}
+
+void BlockStorage::map(const uint8_t bits_per_block, const BlockType *mapped_palette, const size_t palette_count,
+                       const uint64_t *mapped) {
+    ASSERT_DEBUG(bits_per_block == 0 || mapped != nullptr, "packed storage needs its index words");
+    ASSERT_DEBUG(palette_count >= 1 && palette_count <= (size_t{1} << bits_per_block), "palette does not fit bits");
+
+    bits = bits_per_block;
+    palette.reserve(size_t{1} << MAX_BITS);
+    palette.assign(mapped_palette, mapped_palette + palette_count);
+    words.clear();
+    mapped_words = bits == 0 ? nullptr : mapped;
+}
+
+void BlockStorage::detach() {
+    reserve_max();
+    words.assign(mapped_words, mapped_words + words_for(bits));
+    mapped_words = nullptr;
+}
+
+void BlockStorage::unpack(BlockType *out) const {
+    if (bits == 0) {
+        std::fill_n(out, CHUNK_VOLUME, palette[0]);
+        return;
+    }
+
+    const auto mask = (uint64_t{1} << bits) - 1;
+    const uint32_t per_word = 64 / bits;
+    const auto *data = word_data();
+    for (uint32_t i = 0, w = 0; i < CHUNK_VOLUME; w++) {
+        auto word = data[w];
+        for (uint32_t j = 0; j < per_word && i < CHUNK_VOLUME; j++, i++) {
+            out[i] = palette[word & mask];
+            word >>= bits;
+        }
+    }
+}
+
+void BlockStorage::serialize(std::vector<uint8_t> &out) const {
+    out.push_back(bits);
+    write_le(out, static_cast<uint16_t>(palette.size()));
+    for (const auto type: palette)
+        out.push_back(static_cast<uint8_t>(type));
+    const auto *data = word_data();
+    for (size_t w = 0, count = packed_words(bits); w < count; w++)
+        write_le(out, data[w]);
+}
+
+bool BlockStorage::deserialize(const uint8_t *data, const size_t size) {
+    if (size < 3) return false;
+
+    const auto stored_bits = data[0];
+    const auto palette_count = read_le<uint16_t>(data + 1);
+    if (stored_bits != 0 && stored_bits != 1 && stored_bits != 2 && stored_bits != 4 && stored_bits != 8)
+        return false;
+    if (palette_count == 0 || palette_count > (size_t{1} << stored_bits)) return false;
+
+    const auto word_count = packed_words(stored_bits);
+    if (size != 3 + palette_count + word_count * sizeof(uint64_t)) return false;
+    for (size_t i = 0; i < palette_count; i++)
+        if (!is_block_type(data[3 + i])) return false;
+
+    // every index has to point inside the palette, or get() would read past it
+    const auto *stored_words = data + 3 + palette_count;
+    if (stored_bits != 0 && palette_count < (size_t{1} << stored_bits)) {
+        const auto mask = (uint64_t{1} << stored_bits) - 1;
+        for (size_t w = 0; w < word_count; w++) {
+            const auto word = read_le<uint64_t>(stored_words + w * sizeof(uint64_t));
+            for (uint32_t bit = 0; bit < 64; bit += stored_bits)
+                if ((word >> bit & mask) >= palette_count) return false;
+        }
+    }
+
+    bits = stored_bits;
+    mapped_words = nullptr;
+    if (stored_bits != 0) reserve_max();
+    palette.assign(reinterpret_cast<const BlockType *>(data + 3),
+                   reinterpret_cast<const BlockType *>(data + 3 + palette_count));
+    words.resize(word_count);
+    for (size_t w = 0; w < word_count; w++)
+        words[w] = read_le<uint64_t>(stored_words + w * sizeof(uint64_t));
+    return true;
+}
@@ -0,0 +1,114 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_BLOCKSTORAGE_H
+#define MINECRAFT_BLOCKSTORAGE_H
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../WorldConstants.h"
+#include "../blocks/BlockType.h"
+
+// Palette of the block types used in a chunk plus one bit packed palette index per block.
+// Indices use 1, 2, 4 or 8 bits and are widened on demand, so they never straddle two words.
+// With 0 bits the chunk is uniform: every block is palette[0] and no index array is allocated
+// until the first differing write.
+// The index words can also live outside the storage (a mapped world snapshot), they are copied in on the first write.
+class BlockStorage {
+    std::vector<BlockType> palette{BlockType::AIR};
+    std::vector<uint64_t> words{};
+    // when set, the index words are read from here instead of words
+    const uint64_t *mapped_words = nullptr;
+    uint8_t bits = 0;
+
+    static constexpr size_t words_for(const uint8_t bits_per_block) {
+        return (CHUNK_VOLUME * bits_per_block + 63) / 64;
+    }
+
+    // the widest layout a palette of distinct block types needs
+    static constexpr uint8_t MAX_BITS = BLOCK_TYPE_COUNT <= 2 ? 1
+                                        : BLOCK_TYPE_COUNT <= 4 ? 2
+                                        : BLOCK_TYPE_COUNT <= 16 ? 4
+                                        : 8;
+
+    // reserves MAX_BITS up front, so a pooled storage allocates once instead of again on every widen
+    void reserve_max();
+
+    [[nodiscard]] uint32_t read_index(uint32_t index) const;
+
+    void write_index(uint32_t index, uint32_t palette_index);
+
+    void widen();
+
+    // copy on write of mapped index words
+    void detach();
+
+public:
+    [[nodiscard]] BlockType get(const uint32_t index) const {
+        if (bits == 0) return palette[0];
+        return palette[read_index(index)];
+    }
+
+    void set(uint32_t index, BlockType type);
+
+    // drops the palette and the index array, every block becomes type
+    void fill(BlockType type);
+
+    // replaces every block from CHUNK_VOLUME blocks in block_index order, packed as tight as their palette allows
+    void assign(const BlockType *blocks);
+
+    // exchanges the blocks and the allocations behind them
+    void swap(BlockStorage &other) noexcept {
+        palette.swap(other.palette);
+        words.swap(other.words);
+        std::swap(mapped_words, other.mapped_words);
+        std::swap(bits, other.bits);
+    }
+
+    // back to uniform air but keeps the allocated palette/index capacity for reuse
+    void reset();
+
+    [[nodiscard]] bool is_uniform() const { return bits == 0; }
+
+    // only meaningful when is_uniform()
+    [[nodiscard]] BlockType uniform_type() const { return palette[0]; }
+
+    // decodes all CHUNK_VOLUME blocks in block_index order
+    void unpack(BlockType *out) const;
+
+    // appends bits, the palette and the packed indices (little endian words), the uniform case is 4 bytes
+    void serialize(std::vector<uint8_t> &out) const;
+
+    // false on malformed data, the storage is left untouched then
+    bool deserialize(const uint8_t *data, size_t size);
+
+    // reads the packed indices in place from mapped (words_for(bits) words, host byte order) without copying them,
+    // mapped has to stay valid until the storage is written, filled or reset
+    void map(uint8_t bits_per_block, const BlockType *mapped_palette, size_t palette_count, const uint64_t *mapped);
+
+    [[nodiscard]] bool is_mapped() const { return mapped_words != nullptr; }
+
+    // packed_words(bits_per_block()) index words, owned or mapped
+    [[nodiscard]] const uint64_t *word_data() const { return mapped_words != nullptr ? mapped_words : words.data(); }
+
+    [[nodiscard]] const BlockType *palette_data() const { return palette.data(); }
+
+    [[nodiscard]] static constexpr size_t packed_words(const uint8_t bits_per_block) {
+        return bits_per_block == 0 ? 0 : words_for(bits_per_block);
+    }
+
+    [[nodiscard]] uint8_t bits_per_block() const { return bits; }
+
+    [[nodiscard]] size_t palette_size() const { return palette.size(); }
+
+    // heap bytes only, mapped index words belong to the page cache
+    [[nodiscard]] size_t memory_usage() const {
+        return sizeof(*this) + palette.capacity() * sizeof(BlockType) + words.capacity() * sizeof(uint64_t);
+    }
+};
+
+
+#endif //MINECRAFT_BLOCKSTORAGE_H
@@ -4,6 +4,6 @@
 
 #include "Chunk.h"
 
-void Chunk::setIndex(uint8_t chunk_index) {
+void Chunk::setIndex(const ChunkId chunk_index) {
     this->id = chunk_index;
 }
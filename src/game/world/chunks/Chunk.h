@@ -5,25 +5,50 @@
 #ifndef MINECRAFT_CHUNK_H
 #define MINECRAFT_CHUNK_H
 #include <array>
+#include <atomic>
 #include <memory>
 
-#include "../blocks/Block.h"
+#include "BlockStorage.h"
 #include "../WorldConstants.h"
 #include "../blocks/BlockType.h"
+#include "../../../utils/Assert.h"
 
-using ChunkId = int32_t;
+// signed chunk coordinates packed CHUNK_ID_AXIS_BITS each, see World::chunk_id_from_chunk_coords
+using ChunkId = uint64_t;
 
+// Generated chunks go through every state in order, chunks read from disk or the snapshot jump to INITIALIZED.
 enum class ChunkState {
     UNKNOWN = 0,
 
+    // slot reserved in the world, blocks not there yet
     LOADED = 1,
-    INITIALIZED = 2,
+    // grass, dirt and stone from the heightmap
+    TERRAIN = 2,
+    // caves removed, surface is set and neighbours may decorate against it
+    CARVED = 3,
+    // decorated (trees, ores), the blocks are final
+    INITIALIZED = 4,
 };
 
+// local y of a grass block with air above it inside the same chunk for every block column (x + z * CHUNK_SIZE_X),
+// -1 for none. It is what decoration needs to know about a chunk before any feature was placed.
+using ChunkSurface = std::array<int8_t, CHUNK_SIZE_X * CHUNK_SIZE_Z>;
+
 struct Chunk {
     ChunkId id{};
-    std::array<Block, CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z> blocks{};
-    ChunkState state = ChunkState::UNKNOWN;
+    BlockStorage blocks{};
+    // written by the generation workers, each stage is stored after the data it stands for (surface for CARVED,
+    // the final blocks for INITIALIZED) so that every thread that reads it also sees that data
+    std::atomic<ChunkState> state{ChunkState::UNKNOWN};
+    // blocks were changed by setBlock since they were loaded, generated or saved
+    bool dirty = false;
+    // main thread only: handed to a generation worker and not collected by World::finish_chunk_loads yet
+    bool generating = false;
+    // set by the generation worker together with CARVED, false for chunks read from disk or the snapshot
+    bool has_surface = false;
+    ChunkSurface surface{};
+    // loaded face neighbours indexed like directions[], maintained by World::loadChunk/unloadChunk
+    std::array<Chunk *, CUBE_FACES> neighbors{};
 
     Chunk(ChunkId id) : id(id) {
     }
@@ -32,37 +57,53 @@ struct Chunk {
 
     Chunk &operator=(const Chunk &) = delete;
 
-    [[nodiscard]] const Block *getBlock(const int x, const int y, const int z) const {
+    [[nodiscard]] BlockType getBlock(const int x, const int y, const int z) const {
         return getBlock(block_index(x, y, z));
     }
 
-    [[nodiscard]] const Block *getBlock(const uint8_t index) const {
-        return &blocks[index];
+    [[nodiscard]] BlockType getBlock(const uint32_t index) const {
+        return blocks.get(index);
+    }
+
+    void setBlock(const int x, const int y, const int z, const BlockType type) {
+        setBlock(block_index(x, y, z), type);
+    }
+
+    void setBlock(const uint32_t index, const BlockType type) {
+        if (blocks.get(index) == type) return;
+        blocks.set(index, type);
+        dirty = true;
     }
 
     [[nodiscard]] ChunkState getState() const {
-        return state;
+        return state.load(std::memory_order_acquire);
+    }
+
+    // blocks may only be read or written once this is true, until then they belong to a generation worker
+    [[nodiscard]] bool isInitialized() const {
+        return getState() == ChunkState::INITIALIZED;
+    }
+
+    [[nodiscard]] bool reached(const ChunkState stage) const {
+        return getState() >= stage;
     }
 
-    void initializeBlocks() {
-        for (int x = 0; x < CHUNK_SIZE_X; x++) {
-            for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-                for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                    int index = block_index(x, y, z);
-                    blocks[index].setIndex(index);
-                    blocks[index].setBlockType(BlockType::DIRT);
-                }
-            }
-        }
-
-        this->setState(ChunkState::INITIALIZED);
+    // makes a pooled chunk look freshly constructed
+    void reset(const ChunkId chunk_id) {
+        id = chunk_id;
+        blocks.reset();
+        state.store(ChunkState::UNKNOWN, std::memory_order_relaxed);
+        dirty = false;
+        generating = false;
+        has_surface = false;
+        neighbors.fill(nullptr);
     }
 
     void setState(const ChunkState newState) {
-        this->state = newState;
+        state.store(newState, std::memory_order_release);
     }
 
-    void setIndex(uint8_t chunk_index);
+    void setIndex(ChunkId chunk_index);
 
     static constexpr uint32_t block_index(const uint32_t x, const uint32_t y, const uint32_t z) {
         return x + CHUNK_SIZE_X * (y + CHUNK_SIZE_Y * z);
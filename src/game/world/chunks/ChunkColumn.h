@@ -0,0 +1,57 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKCOLUMN_H
+#define MINECRAFT_CHUNKCOLUMN_H
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+#include "../WorldConstants.h"
+
+#define CHUNK_COLUMN_AREA (CHUNK_SIZE_X * CHUNK_SIZE_Z)
+// highest_block of a block column without any solid block in its loaded chunks
+#define COLUMN_NO_BLOCK INT32_MIN
+
+// Per block column heights of one vertical stack of chunks, cached by World next to the chunks while any chunk of the
+// stack is loaded. Both arrays are indexed x + z * CHUNK_SIZE_X with x and z local to the chunk.
+struct ChunkColumn {
+    // surface height the generator uses, computed once for every chunk of the stack
+    std::array<int32_t, CHUNK_COLUMN_AREA> terrain{};
+    // highest non air block over the initialized chunks, kept up to date by World on loads, unloads and setBlock
+    std::array<int32_t, CHUNK_COLUMN_AREA> highest{};
+    // chunk y of every initialized chunk, highest first
+    std::vector<int32_t> chunk_ys{};
+    // reserved chunks of the stack, initialized or not, the column is dropped at 0
+    uint32_t chunks = 0;
+
+    ChunkColumn() {
+        highest.fill(COLUMN_NO_BLOCK);
+    }
+
+    // makes a pooled column look freshly constructed, keeps the chunk_ys capacity
+    void reset() {
+        highest.fill(COLUMN_NO_BLOCK);
+        chunk_ys.clear();
+        chunks = 0;
+    }
+
+    static constexpr uint32_t index(const int32_t x, const int32_t z) {
+        return static_cast<uint32_t>(x + z * CHUNK_SIZE_X);
+    }
+
+    void add_chunk_y(const int32_t chunk_y) {
+        chunk_ys.insert(std::upper_bound(chunk_ys.begin(), chunk_ys.end(), chunk_y, std::greater<>()), chunk_y);
+    }
+
+    void remove_chunk_y(const int32_t chunk_y) {
+        const auto it = std::find(chunk_ys.begin(), chunk_ys.end(), chunk_y);
+        if (it != chunk_ys.end()) chunk_ys.erase(it);
+    }
+};
+
+
+#endif //MINECRAFT_CHUNKCOLUMN_H
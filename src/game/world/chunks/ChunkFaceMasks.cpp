@@ -0,0 +1,70 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ChunkFaceMasks.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define SNAPSHOT_SIZE_MAX (CHUNK_SIZE_MAX + 2)
+
+// bit x set for every non air block of a padded snapshot row
+static uint32_t solid_row(const BlockType *block) {
+    uint32_t row = 0;
+    auto x = 0;
+#if defined(__SSE2__)
+    static_assert(sizeof(BlockType) == 1, "rows are compared 16 blocks at a time");
+    for (; x + 16 <= SNAPSHOT_SIZE_X; x += 16) {
+        const auto blocks = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + x));
+        const auto air = _mm_movemask_epi8(_mm_cmpeq_epi8(blocks, _mm_setzero_si128()));
+        row |= (~static_cast<uint32_t>(air) & 0xFFFF) << x;
+    }
+#endif
+    for (; x < SNAPSHOT_SIZE_X; x++)
+        row |= static_cast<uint32_t>(block[x] != BlockType::AIR) << x;
+    return row;
+}
+
+void ChunkFaceMasks::compute(const ChunkSnapshot &snapshot, ChunkFaceMasks &masks) {
+    // solid[pz][py]: bit px set when the padded block is solid, borders included
+    uint32_t solid[SNAPSHOT_SIZE_MAX][SNAPSHOT_SIZE_MAX];
+    const auto *block = snapshot.blocks.data();
+    for (auto z = 0; z < SNAPSHOT_SIZE_Z; z++) {
+        for (auto y = 0; y < SNAPSHOT_SIZE_Y; y++) {
+            solid[z][y] = solid_row(block);
+            block += SNAPSHOT_SIZE_X;
+        }
+    }
+
+    for (auto &slices: masks.slices) slices = 0;
+
+    // the padding bit is dropped so bit x is block x of the chunk, faces in the order of directions[]
+    constexpr auto interior = (1u << CHUNK_SIZE_X) - 1;
+    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+        const auto *back = solid[z];
+        const auto *row = solid[z + 1];
+        const auto *front = solid[z + 2];
+        for (auto y = 0; y < CHUNK_SIZE_Y; y++) {
+            const auto blocks = row[y + 1];
+            masks.rows[0][z][y] = static_cast<uint16_t>((blocks & ~front[y + 1]) >> 1 & interior);
+            masks.rows[1][z][y] = static_cast<uint16_t>((blocks & ~back[y + 1]) >> 1 & interior);
+            masks.rows[2][z][y] = static_cast<uint16_t>((blocks & ~(blocks << 1)) >> 1 & interior);
+            masks.rows[3][z][y] = static_cast<uint16_t>((blocks & ~(blocks >> 1)) >> 1 & interior);
+            masks.rows[4][z][y] = static_cast<uint16_t>((blocks & ~row[y + 2]) >> 1 & interior);
+            masks.rows[5][z][y] = static_cast<uint16_t>((blocks & ~row[y]) >> 1 & interior);
+        }
+    }
+
+    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (auto y = 0; y < CHUNK_SIZE_Y; y++) {
+            masks.slices[0] |= (masks.rows[0][z][y] != 0) << z;
+            masks.slices[1] |= (masks.rows[1][z][y] != 0) << z;
+            masks.slices[2] |= masks.rows[2][z][y];
+            masks.slices[3] |= masks.rows[3][z][y];
+            masks.slices[4] |= (masks.rows[4][z][y] != 0) << y;
+            masks.slices[5] |= (masks.rows[5][z][y] != 0) << y;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKFACEMASKS_H
+#define MINECRAFT_CHUNKFACEMASKS_H
+#include <cstdint>
+
+#include "ChunkSnapshot.h"
+
+#define CHUNK_SIZE_MAX 16
+
+static_assert(CHUNK_SIZE_X <= CHUNK_SIZE_MAX && CHUNK_SIZE_Y <= CHUNK_SIZE_MAX && CHUNK_SIZE_Z <= CHUNK_SIZE_MAX,
+              "face masks hold one row of blocks per 16 bit word");
+
+// Exposed block faces of a chunk as bitmasks. For every face (indexed like directions[]) rows[face][z][y] has bit x
+// set when the block is solid and its neighbour in the face direction is air.
+struct ChunkFaceMasks {
+    uint16_t rows[CUBE_FACES][CHUNK_SIZE_MAX][CHUNK_SIZE_MAX];
+    // bit k set when slice k along the face normal has any exposed face
+    uint16_t slices[CUBE_FACES];
+
+    [[nodiscard]] bool exposed(const int face, const int x, const int y, const int z) const {
+        return rows[face][z][y] >> x & 1;
+    }
+
+    // packs the snapshot into solid bit rows along x, then every face is a shift or a neighbouring row and a mask
+    static void compute(const ChunkSnapshot &snapshot, ChunkFaceMasks &masks);
+};
+
+inline int lowest_set_bit(const uint32_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(bits);
+#else
+    int index = 0;
+    while (!(bits >> index & 1)) index++;
+    return index;
+#endif
+}
+
+
+#endif //MINECRAFT_CHUNKFACEMASKS_H
@@ -0,0 +1,162 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ChunkMesher.h"
+
+#include "ChunkFaceMasks.h"
+
+static constexpr int chunk_size[3] = {CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z};
+
+static_assert(CHUNK_SIZE_X <= 16 && CHUNK_SIZE_Y <= 16 && CHUNK_SIZE_Z <= 16,
+              "packed chunk vertices store corners in 5 bits per axis");
+static_assert(CHUNK_MAX_QUADS * QUAD_VERTICES <= 65536, "chunk meshes are drawn with 16 bit indices");
+
+void ChunkMesher::mesh(const ChunkSnapshot &snapshot, const MeshingMode mode, std::vector<ChunkVertex> &vertices) {
+    if (snapshot.uniform && snapshot.uniform_type == BlockType::AIR) return;
+
+    switch (mode) {
+        case MeshingMode::NAIVE:
+            mesh_naive(snapshot, vertices);
+            break;
+        case MeshingMode::GREEDY:
+            mesh_greedy(snapshot, vertices);
+            break;
+    }
+}
+
+// stretches the unit face over size[] blocks starting at start[], texture coordinates tile once per block
+static void emit_face(const int face, const int start[3], const int size[3], const BlockType type,
+                      std::vector<ChunkVertex> &vertices) {
+    const auto u = faceTextureAxes[face][0];
+    const auto v = faceTextureAxes[face][1];
+
+    for (int vertex = 0; vertex < QUAD_VERTICES * 5; vertex += 5) {
+        uint32_t corner[3];
+        for (auto axis = 0; axis < 3; axis++) {
+            const auto far_side = faceVertices[face][vertex + axis] > 0;
+            corner[axis] = start[axis] + (far_side ? size[axis] : 0);
+        }
+        const auto tex_u = faceVertices[face][vertex + 3] > 0 ? size[u] : 0;
+        const auto tex_v = faceVertices[face][vertex + 4] > 0 ? size[v] : 0;
+        vertices.push_back(ChunkMesher::pack_vertex(corner[0], corner[1], corner[2], tex_u, tex_v, face,
+                                                    static_cast<uint32_t>(type)));
+    }
+}
+
+// a fully solid chunk can only expose the layer of blocks facing each neighbour
+static void mesh_naive_uniform(const ChunkSnapshot &snapshot, std::vector<ChunkVertex> &vertices) {
+    static constexpr int unit[3] = {1, 1, 1};
+
+    for (auto face = 0; face < CUBE_FACES; ++face) {
+        const auto d = directions[face][0] != 0 ? 0 : directions[face][1] != 0 ? 1 : 2;
+        const auto u = faceTextureAxes[face][0];
+        const auto v = faceTextureAxes[face][1];
+
+        int position[3];
+        position[d] = directions[face][d] > 0 ? chunk_size[d] - 1 : 0;
+        for (auto j = 0; j < chunk_size[v]; j++) {
+            position[v] = j;
+            for (auto i = 0; i < chunk_size[u]; i++) {
+                position[u] = i;
+                if (snapshot.at(position[0] + directions[face][0],
+                                position[1] + directions[face][1],
+                                position[2] + directions[face][2]) != BlockType::AIR)
+                    continue;
+
+                emit_face(face, position, unit, snapshot.uniform_type, vertices);
+            }
+        }
+    }
+}
+
+void ChunkMesher::mesh_naive(const ChunkSnapshot &snapshot, std::vector<ChunkVertex> &vertices) {
+    static constexpr int unit[3] = {1, 1, 1};
+
+    if (snapshot.uniform) {
+        mesh_naive_uniform(snapshot, vertices);
+        return;
+    }
+
+    ChunkFaceMasks masks;
+    ChunkFaceMasks::compute(snapshot, masks);
+
+    for (auto face = 0; face < CUBE_FACES; ++face) {
+        for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+            for (auto y = 0; y < CHUNK_SIZE_Y; y++) {
+                for (uint32_t bits = masks.rows[face][z][y]; bits != 0; bits &= bits - 1) {
+                    const int position[3] = {lowest_set_bit(bits), y, z};
+                    emit_face(face, position, unit, snapshot.at(position[0], position[1], position[2]), vertices);
+                }
+            }
+        }
+    }
+}
+
+void ChunkMesher::mesh_greedy(const ChunkSnapshot &snapshot, std::vector<ChunkVertex> &vertices) {
+    ChunkFaceMasks masks;
+    ChunkFaceMasks::compute(snapshot, masks);
+
+    std::vector<BlockType> mask;
+    for (auto face = 0; face < CUBE_FACES; ++face) {
+        // d is the axis the face points along, u/v are the axes the texture coordinates follow
+        const auto d = directions[face][0] != 0 ? 0 : directions[face][1] != 0 ? 1 : 2;
+        const auto u = faceTextureAxes[face][0];
+        const auto v = faceTextureAxes[face][1];
+        const auto size_u = chunk_size[u];
+        const auto size_v = chunk_size[v];
+        mask.assign(size_u * size_v, BlockType::AIR);
+
+        for (auto k = 0; k < chunk_size[d]; k++) {
+            if (!(masks.slices[face] >> k & 1)) continue;
+
+            int position[3];
+            position[d] = k;
+            for (auto j = 0; j < size_v; j++) {
+                position[v] = j;
+                for (auto i = 0; i < size_u; i++) {
+                    position[u] = i;
+                    mask[i + j * size_u] = masks.exposed(face, position[0], position[1], position[2])
+                                               ? snapshot.at(position[0], position[1], position[2])
+                                               : BlockType::AIR;
+                }
+            }
+
+            for (auto j = 0; j < size_v; j++) {
+                for (auto i = 0; i < size_u;) {
+                    const auto type = mask[i + j * size_u];
+                    if (type == BlockType::AIR) {
+                        i++;
+                        continue;
+                    }
+
+                    auto width = 1;
+                    while (i + width < size_u && mask[i + width + j * size_u] == type) width++;
+
+                    auto height = 1;
+                    for (; j + height < size_v; height++) {
+                        auto row_matches = true;
+                        for (auto w = 0; w < width && row_matches; w++)
+                            row_matches = mask[i + w + (j + height) * size_u] == type;
+                        if (!row_matches) break;
+                    }
+
+                    for (auto h = 0; h < height; h++)
+                        for (auto w = 0; w < width; w++)
+                            mask[i + w + (j + h) * size_u] = BlockType::AIR;
+
+                    int start[3], size[3];
+                    start[d] = k;
+                    start[u] = i;
+                    start[v] = j;
+                    size[d] = 1;
+                    size[u] = width;
+                    size[v] = height;
+                    emit_face(face, start, size, type, vertices);
+
+                    i += width;
+                }
+            }
+        }
+    }
+}
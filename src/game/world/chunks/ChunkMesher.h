@@ -0,0 +1,42 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKMESHER_H
+#define MINECRAFT_CHUNKMESHER_H
+#include <vector>
+
+#include "ChunkSnapshot.h"
+
+enum class MeshingMode {
+    // one quad per exposed block face
+    NAIVE = 0,
+    // coplanar faces of the same block type merged into maximal rectangles per chunk slice
+    GREEDY = 1,
+};
+
+// Chunk relative vertex packed in 32 bits, the shader adds the chunk origin back:
+// bits 0-14 block corner x/y/z (5 bits each, 0..16), 15-24 texture u/v (5 bits each, 0..16 tiles),
+// 25-27 face, 28-31 block type
+using ChunkVertex = uint32_t;
+
+static_assert(BLOCK_TYPE_COUNT <= 16, "block type no longer fits the 4 vertex bits, widen ChunkVertex");
+
+// Emits QUAD_VERTICES vertices per face, drawn through the shared quad index buffer.
+// Pure function of a ChunkSnapshot, safe to run on any thread.
+struct ChunkMesher {
+    static void mesh(const ChunkSnapshot &snapshot, MeshingMode mode, std::vector<ChunkVertex> &vertices);
+
+    static void mesh_naive(const ChunkSnapshot &snapshot, std::vector<ChunkVertex> &vertices);
+
+    static void mesh_greedy(const ChunkSnapshot &snapshot, std::vector<ChunkVertex> &vertices);
+
+    static constexpr ChunkVertex pack_vertex(const uint32_t x, const uint32_t y, const uint32_t z,
+                                             const uint32_t u, const uint32_t v,
+                                             const uint32_t face, const uint32_t block_type) {
+        return x | y << 5 | z << 10 | u << 15 | v << 20 | face << 25 | (block_type & 0xF) << 28;
+    }
+};
+
+
+#endif //MINECRAFT_CHUNKMESHER_H
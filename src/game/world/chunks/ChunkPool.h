@@ -0,0 +1,18 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKPOOL_H
+#define MINECRAFT_CHUNKPOOL_H
+#include "Chunk.h"
+#include "ChunkColumn.h"
+#include "../../../utils/SlabPool.h"
+
+// chunks and the columns World caches next to them come and go with streaming, both are recycled instead of
+// allocated per load
+using ChunkPool = SlabPool<Chunk, CHUNK_POOL_SLAB_CHUNKS>;
+
+using ChunkColumnPool = SlabPool<ChunkColumn, CHUNK_COLUMN_POOL_SLAB_COLUMNS>;
+
+
+#endif //MINECRAFT_CHUNKPOOL_H
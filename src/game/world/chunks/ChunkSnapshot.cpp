@@ -0,0 +1,58 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ChunkSnapshot.h"
+
+#include <algorithm>
+
+#include "../World.h"
+
+void ChunkSnapshot::capture(const Chunk &chunk, ChunkSnapshot &snapshot) {
+    snapshot.id = chunk.id;
+    snapshot.blocks.fill(BlockType::AIR);
+
+    snapshot.uniform = chunk.blocks.is_uniform();
+    snapshot.uniform_type = chunk.blocks.uniform_type();
+    if (snapshot.uniform) {
+        if (snapshot.uniform_type != BlockType::AIR)
+            for (auto z = 0; z < CHUNK_SIZE_Z; z++)
+                for (auto y = 0; y < CHUNK_SIZE_Y; y++)
+                    std::fill_n(&snapshot.blocks[padded_index(0, y, z)], CHUNK_SIZE_X, snapshot.uniform_type);
+    } else {
+        std::array<BlockType, CHUNK_VOLUME> interior;
+        chunk.blocks.unpack(interior.data());
+        for (auto z = 0; z < CHUNK_SIZE_Z; z++)
+            for (auto y = 0; y < CHUNK_SIZE_Y; y++)
+                std::copy_n(&interior[Chunk::block_index(0, y, z)], CHUNK_SIZE_X,
+                            &snapshot.blocks[padded_index(0, y, z)]);
+    }
+
+    ASSERT_DEBUG(World::chunk_id_from_world_coords(World::chunk_id_to_world_coordinates(chunk.id)) == chunk.id,
+                 "Mismatch chunking id => coordinates");
+    for (auto face = 0; face < CUBE_FACES; ++face) {
+        // a neighbour that is still generating counts as missing, it remeshes this chunk once it is done
+        if (chunk.neighbors[face] == nullptr || !chunk.neighbors[face]->isInitialized()) continue;
+        const auto &neighbor = *chunk.neighbors[face];
+
+        // the layer of the neighbour touching this chunk lands in the matching border of the snapshot
+        const auto d = directions[face][0] != 0 ? 0 : directions[face][1] != 0 ? 1 : 2;
+        const int chunk_size[3] = {CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z};
+        const auto border = directions[face][d] > 0 ? chunk_size[d] : -1;
+        const auto source = directions[face][d] > 0 ? 0 : chunk_size[d] - 1;
+        const auto u = (d + 1) % 3;
+        const auto v = (d + 2) % 3;
+
+        for (auto j = 0; j < chunk_size[v]; j++) {
+            for (auto i = 0; i < chunk_size[u]; i++) {
+                int from[3], to[3];
+                from[d] = source;
+                to[d] = border;
+                from[u] = to[u] = i;
+                from[v] = to[v] = j;
+                snapshot.blocks[padded_index(to[0], to[1], to[2])] =
+                        neighbor.getBlock(from[0], from[1], from[2]);
+            }
+        }
+    }
+}
@@ -0,0 +1,38 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKSNAPSHOT_H
+#define MINECRAFT_CHUNKSNAPSHOT_H
+#include <array>
+
+#include "Chunk.h"
+
+#define SNAPSHOT_SIZE_X (CHUNK_SIZE_X + 2)
+#define SNAPSHOT_SIZE_Y (CHUNK_SIZE_Y + 2)
+#define SNAPSHOT_SIZE_Z (CHUNK_SIZE_Z + 2)
+
+// Immutable copy of a chunk's block types padded with a one block border taken from its six face neighbours,
+// so it can be meshed away from the main thread without touching World.
+struct ChunkSnapshot {
+    ChunkId id{};
+    // every block inside the chunk (not the borders) is uniform_type
+    bool uniform = false;
+    BlockType uniform_type = BlockType::AIR;
+    std::array<BlockType, SNAPSHOT_SIZE_X * SNAPSHOT_SIZE_Y * SNAPSHOT_SIZE_Z> blocks{};
+
+    // chunk local coordinates, -1 and CHUNK_SIZE_* address the neighbour borders
+    [[nodiscard]] BlockType at(const int x, const int y, const int z) const {
+        return blocks[padded_index(x, y, z)];
+    }
+
+    static constexpr uint32_t padded_index(const int x, const int y, const int z) {
+        return (x + 1) + SNAPSHOT_SIZE_X * ((y + 1) + SNAPSHOT_SIZE_Y * (z + 1));
+    }
+
+    // reads the neighbours through Chunk::neighbors, must run on the thread owning the world
+    static void capture(const Chunk &chunk, ChunkSnapshot &snapshot);
+};
+
+
+#endif //MINECRAFT_CHUNKSNAPSHOT_H
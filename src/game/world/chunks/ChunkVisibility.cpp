@@ -0,0 +1,77 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ChunkVisibility.h"
+
+#include <bitset>
+#include <vector>
+
+// bitmask of the chunk faces (as in directions[]) the block lies on
+static uint8_t touched_faces(const int x, const int y, const int z) {
+    uint8_t faces = 0;
+    if (z == CHUNK_SIZE_Z - 1) faces |= 1 << 0;
+    if (z == 0) faces |= 1 << 1;
+    if (x == 0) faces |= 1 << 2;
+    if (x == CHUNK_SIZE_X - 1) faces |= 1 << 3;
+    if (y == CHUNK_SIZE_Y - 1) faces |= 1 << 4;
+    if (y == 0) faces |= 1 << 5;
+    return faces;
+}
+
+ChunkVisibility ChunkVisibility::compute(const ChunkSnapshot &snapshot) {
+    if (snapshot.uniform)
+        return snapshot.uniform_type == BlockType::AIR ? all_connected() : ChunkVisibility{};
+
+    ChunkVisibility visibility;
+    std::bitset<CHUNK_VOLUME> visited;
+    std::vector<uint32_t> stack;
+    stack.reserve(CHUNK_VOLUME);
+
+    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (auto y = 0; y < CHUNK_SIZE_Y; y++) {
+            for (auto x = 0; x < CHUNK_SIZE_X; x++) {
+                // regions not touching the border cannot connect anything
+                if (touched_faces(x, y, z) == 0) continue;
+
+                const auto start = Chunk::block_index(x, y, z);
+                if (visited[start] || snapshot.at(x, y, z) != BlockType::AIR) continue;
+
+                uint8_t region_faces = 0;
+                visited[start] = true;
+                stack.push_back(start);
+                while (!stack.empty()) {
+                    const auto index = stack.back();
+                    stack.pop_back();
+
+                    const int block_x = index % CHUNK_SIZE_X;
+                    const int block_y = index / CHUNK_SIZE_X % CHUNK_SIZE_Y;
+                    const int block_z = index / (CHUNK_SIZE_X * CHUNK_SIZE_Y);
+                    region_faces |= touched_faces(block_x, block_y, block_z);
+
+                    for (const auto &direction: directions) {
+                        const auto nx = block_x + direction[0];
+                        const auto ny = block_y + direction[1];
+                        const auto nz = block_z + direction[2];
+                        if (nx < 0 || nx >= CHUNK_SIZE_X ||
+                            ny < 0 || ny >= CHUNK_SIZE_Y ||
+                            nz < 0 || nz >= CHUNK_SIZE_Z)
+                            continue;
+
+                        const auto neighbor = Chunk::block_index(nx, ny, nz);
+                        if (visited[neighbor] || snapshot.at(nx, ny, nz) != BlockType::AIR) continue;
+
+                        visited[neighbor] = true;
+                        stack.push_back(neighbor);
+                    }
+                }
+
+                for (auto a = 0; a < CUBE_FACES; a++)
+                    for (auto b = 0; b < CUBE_FACES; b++)
+                        if ((region_faces >> a & 1) && (region_faces >> b & 1))
+                            visibility.connect(a, b);
+            }
+        }
+    }
+    return visibility;
+}
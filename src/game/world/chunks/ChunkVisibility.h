@@ -0,0 +1,37 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKVISIBILITY_H
+#define MINECRAFT_CHUNKVISIBILITY_H
+#include <cstdint>
+
+#include "ChunkSnapshot.h"
+
+// Which pairs of chunk faces (indexed like directions[]) can see each other through non solid blocks of the chunk.
+struct ChunkVisibility {
+    uint64_t connections = 0;
+
+    [[nodiscard]] bool connected(const int from_face, const int to_face) const {
+        return connections >> (from_face * CUBE_FACES + to_face) & 1;
+    }
+
+    void connect(const int from_face, const int to_face) {
+        connections |= uint64_t{1} << (from_face * CUBE_FACES + to_face);
+        connections |= uint64_t{1} << (to_face * CUBE_FACES + from_face);
+    }
+
+    static ChunkVisibility all_connected() {
+        ChunkVisibility visibility;
+        for (auto a = 0; a < CUBE_FACES; a++)
+            for (auto b = 0; b < CUBE_FACES; b++)
+                visibility.connect(a, b);
+        return visibility;
+    }
+
+    // flood fills every air region of the chunk and connects the faces each region touches
+    static ChunkVisibility compute(const ChunkSnapshot &snapshot);
+};
+
+
+#endif //MINECRAFT_CHUNKVISIBILITY_H
@@ -0,0 +1,92 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "Decorator.h"
+
+#include "Noise.h"
+#include "../World.h"
+
+// keep trees and ores from rolling the same numbers
+static constexpr uint32_t TREE_SALT = 0x7EE5A11Du;
+static constexpr uint32_t ORE_SALT = 0x0DE5C0A1u;
+
+void Decorator::decorate(const ChunkId chunk_id, const ChunkSurface *surfaces, BlockStorage &blocks) const {
+    place_ores(chunk_id, blocks);
+    place_trees(chunk_id, surfaces, blocks);
+}
+
+void Decorator::place_trees(const ChunkId chunk_id, const ChunkSurface *surfaces, BlockStorage &blocks) const {
+    const auto [chunk_x, chunk_y, chunk_z] = World::chunk_id_to_chunk_coords(chunk_id);
+
+    // x, y, z are relative to the decorated chunk, everything outside of it belongs to another chunk's decoration
+    const auto place = [&blocks](const int x, const int y, const int z, const BlockType type) {
+        if (x < 0 || y < 0 || z < 0 || x >= CHUNK_SIZE_X || y >= CHUNK_SIZE_Y || z >= CHUNK_SIZE_Z) return;
+        const auto index = Chunk::block_index(x, y, z);
+        const auto current = blocks.get(index);
+        // logs win over leaves, so overlapping trees come out the same in any order
+        if (current == BlockType::AIR || (type == BlockType::LOG && current == BlockType::LEAVES))
+            blocks.set(index, type);
+    };
+
+    for (auto i = 0; i < DECORATION_NEIGHBORHOOD; i++) {
+        const auto *offset = neighbor_offsets[i];
+        const auto tree_seed = Noise::hash(Noise::hash(seed ^ TREE_SALT, chunk_x + offset[0], chunk_z + offset[2]),
+                                           chunk_y + offset[1], 0);
+
+        for (auto attempt = 0; attempt < DECORATION_TREE_ATTEMPTS; attempt++) {
+            const auto roll = Noise::hash(tree_seed, attempt, 0);
+            if (roll >> 16 & 1) continue;
+
+            const auto column_x = static_cast<int>(roll % CHUNK_SIZE_X);
+            const auto column_z = static_cast<int>(roll / CHUNK_SIZE_X % CHUNK_SIZE_Z);
+            const auto ground = surfaces[i][column_x + column_z * CHUNK_SIZE_X];
+            if (ground < 0) continue;
+
+            const auto x = offset[0] * CHUNK_SIZE_X + column_x;
+            const auto y = offset[1] * CHUNK_SIZE_Y + ground;
+            const auto z = offset[2] * CHUNK_SIZE_Z + column_z;
+            const auto trunk = DECORATION_TREE_MIN_TRUNK + static_cast<int>(roll >> 8 & 0xFF) % 3;
+
+            // two wide layers around the top of the trunk and two narrow ones above it
+            for (auto layer = trunk - 1; layer <= trunk + 2; layer++) {
+                const auto radius = layer <= trunk ? 2 : 1;
+                for (auto dz = -radius; dz <= radius; dz++) {
+                    for (auto dx = -radius; dx <= radius; dx++) {
+                        const auto corner = (dx == -radius || dx == radius) && (dz == -radius || dz == radius);
+                        if (corner && (radius == 2 || layer == trunk + 2)) continue;
+                        place(x + dx, y + layer, z + dz, BlockType::LEAVES);
+                    }
+                }
+            }
+            for (auto height = 1; height <= trunk; height++)
+                place(x, y + height, z, BlockType::LOG);
+
+            if (x >= 0 && y >= 0 && z >= 0 && x < CHUNK_SIZE_X && y < CHUNK_SIZE_Y && z < CHUNK_SIZE_Z)
+                blocks.set(Chunk::block_index(x, y, z), BlockType::DIRT);
+        }
+    }
+}
+
+void Decorator::place_ores(const ChunkId chunk_id, BlockStorage &blocks) const {
+    const auto [chunk_x, chunk_y, chunk_z] = World::chunk_id_to_chunk_coords(chunk_id);
+    if (chunk_y * CHUNK_SIZE_Y >= DECORATION_ORE_MAX_HEIGHT) return;
+    if (blocks.is_uniform() && blocks.uniform_type() != BlockType::STONE) return;
+
+    const auto ore_seed = Noise::hash(Noise::hash(seed ^ ORE_SALT, chunk_x, chunk_z), chunk_y, 0);
+    for (auto attempt = 0; attempt < DECORATION_ORE_ATTEMPTS; attempt++) {
+        const auto roll = Noise::hash(ore_seed, attempt, 0);
+        // a vein is at most 3x3x3 around its centre, keeping the centre off the border keeps it in this chunk
+        const auto x = 1 + static_cast<int>(roll % (CHUNK_SIZE_X - 2));
+        const auto y = 1 + static_cast<int>((roll >> 8) % (CHUNK_SIZE_Y - 2));
+        const auto z = 1 + static_cast<int>((roll >> 16) % (CHUNK_SIZE_Z - 2));
+        if (chunk_y * CHUNK_SIZE_Y + y >= DECORATION_ORE_MAX_HEIGHT) continue;
+
+        const auto shape = Noise::hash(roll, attempt, 1);
+        for (auto cell = 0; cell < 27; cell++) {
+            if (!(shape >> cell & 1)) continue;
+            const auto index = Chunk::block_index(x + cell % 3 - 1, y + cell / 3 % 3 - 1, z + cell / 9 - 1);
+            if (blocks.get(index) == BlockType::STONE) blocks.set(index, BlockType::COAL_ORE);
+        }
+    }
+}
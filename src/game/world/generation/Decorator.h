@@ -0,0 +1,43 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_DECORATOR_H
+#define MINECRAFT_DECORATOR_H
+#include <cstdint>
+
+#include "../chunks/Chunk.h"
+
+// chunks whose features can reach into a chunk: the 3x3 chunk columns around it, at its height and one chunk below
+#define DECORATION_NEIGHBORHOOD 18
+// index of the decorated chunk itself in the neighbourhood
+#define DECORATION_SELF 13
+
+// Last generation stage. Trees may grow across chunk borders, so decorating a chunk replays the trees of every chunk
+// in its neighbourhood and keeps only the blocks that land inside the chunk. The tree spots come from hashing the
+// seed with the chunk coordinates and the (carved) surfaces of the neighbours, so every chunk agrees on the trees
+// without ever writing into another chunk. Ore veins stay inside the chunk that rolls them.
+struct Decorator {
+    uint32_t seed;
+
+    explicit Decorator(const uint32_t seed) : seed(seed) {
+    }
+
+    // chunk offset (x, y, z) of every neighbourhood entry
+    static constexpr int neighbor_offsets[DECORATION_NEIGHBORHOOD][3] = {
+        {-1, -1, -1}, {0, -1, -1}, {1, -1, -1}, {-1, -1, 0}, {0, -1, 0}, {1, -1, 0},
+        {-1, -1, 1}, {0, -1, 1}, {1, -1, 1}, {-1, 0, -1}, {0, 0, -1}, {1, 0, -1},
+        {-1, 0, 0}, {0, 0, 0}, {1, 0, 0}, {-1, 0, 1}, {0, 0, 1}, {1, 0, 1},
+    };
+
+    // surfaces[i] is the surface of the chunk at neighbor_offsets[i] from chunk_id
+    void decorate(ChunkId chunk_id, const ChunkSurface *surfaces, BlockStorage &blocks) const;
+
+private:
+    void place_trees(ChunkId chunk_id, const ChunkSurface *surfaces, BlockStorage &blocks) const;
+
+    void place_ores(ChunkId chunk_id, BlockStorage &blocks) const;
+};
+
+
+#endif //MINECRAFT_DECORATOR_H
@@ -0,0 +1,40 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_GENERATIONJOB_H
+#define MINECRAFT_GENERATIONJOB_H
+#include <array>
+#include <cstdint>
+
+#include "Decorator.h"
+#include "../chunks/ChunkColumn.h"
+#include "../../../utils/SlabPool.h"
+
+// Everything one generation_pool job works on. Jobs are taken from a GenerationJobPool on the main thread and given
+// back there once the worker handed the chunk back, so the submitted closure only holds pointers and the thread pool
+// never allocates for it.
+struct GenerationJob {
+    Chunk *chunk;
+    // terrain stage: surface heights of the chunk's column, a copy because the column may be dropped while it runs
+    std::array<int32_t, CHUNK_COLUMN_AREA> heights{};
+    // decoration stage: surfaces of the decoration neighbourhood, the ones listed in missing_surfaces are generated by
+    // the worker
+    std::array<ChunkSurface, DECORATION_NEIGHBORHOOD> surfaces{};
+    std::array<uint8_t, DECORATION_NEIGHBORHOOD> missing_surfaces{};
+    size_t missing = 0;
+
+    explicit GenerationJob(Chunk *chunk) : chunk(chunk) {
+    }
+
+    // the arrays are overwritten by every job that reads them
+    void reset(Chunk *target) {
+        chunk = target;
+        missing = 0;
+    }
+};
+
+using GenerationJobPool = SlabPool<GenerationJob, GENERATION_JOB_POOL_SLAB_JOBS>;
+
+
+#endif //MINECRAFT_GENERATIONJOB_H
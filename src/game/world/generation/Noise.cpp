@@ -0,0 +1,163 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "Noise.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "NoiseKernel.h"
+
+#ifdef MINECRAFT_NOISE_AVX2
+// NoiseAvx2.cpp, built with -mavx2 and only called after the cpu check
+void noise_fbm2d_grid_avx2(uint32_t seed, int32_t x, int32_t z, int count_x, int count_z, float scale, int octaves,
+                           float *out);
+
+void noise_gradient3d_grid_avx2(uint32_t seed, int32_t x, int32_t y, int32_t z, int count_x, int count_y, int count_z,
+                                int32_t spacing, float scale, float *out);
+#endif
+
+#ifdef __SSE2__
+namespace {
+    struct Sse2Lanes {
+        static constexpr int width = 4;
+        using F = __m128;
+        using I = __m128i;
+        using M = __m128;
+
+        static F set(const float value) { return _mm_set1_ps(value); }
+        static I set_int(const uint32_t value) { return _mm_set1_epi32(static_cast<int32_t>(value)); }
+
+        static F sequence(const int32_t start, const int32_t step) {
+            return _mm_cvtepi32_ps(_mm_setr_epi32(start, start + step, start + 2 * step, start + 3 * step));
+        }
+
+        static void store(float *out, const F value) { _mm_storeu_ps(out, value); }
+
+        static F add(const F a, const F b) { return _mm_add_ps(a, b); }
+        static F sub(const F a, const F b) { return _mm_sub_ps(a, b); }
+        static F mul(const F a, const F b) { return _mm_mul_ps(a, b); }
+        static F div(const F a, const F b) { return _mm_div_ps(a, b); }
+
+        static I add_int(const I a, const I b) { return _mm_add_epi32(a, b); }
+
+        // no 32 bit mullo before SSE4.1: multiply even and odd lanes to 64 bits and keep the low halves
+        static I mul_int(const I a, const I b) {
+            const auto even = _mm_mul_epu32(a, b);
+            const auto odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                      _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        }
+
+        static I xor_int(const I a, const I b) { return _mm_xor_si128(a, b); }
+
+        template<int bits>
+        static I shift_right(const I a) { return _mm_srli_epi32(a, bits); }
+
+        static I floor(const F x, F &floor_x) {
+            auto truncated = _mm_cvttps_epi32(x);
+            auto truncated_x = _mm_cvtepi32_ps(truncated);
+            // truncation rounded a negative value up, all ones is -1
+            const auto above = _mm_cmpgt_ps(truncated_x, x);
+            truncated = _mm_add_epi32(truncated, _mm_castps_si128(above));
+            floor_x = _mm_sub_ps(truncated_x, _mm_and_ps(above, _mm_set1_ps(1.0f)));
+            return truncated;
+        }
+
+        static M bit_set(const I a, const uint32_t bit) {
+            const auto bit_lanes = set_int(bit);
+            return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, bit_lanes), bit_lanes));
+        }
+
+        static M select_mask(const M m, const M a, const M b) { return select(m, a, b); }
+        static F select(const M m, const F a, const F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+        static F negate_if(const M m, const F a) { return _mm_xor_ps(a, _mm_and_ps(m, _mm_set1_ps(-0.0f))); }
+    };
+}
+#endif
+
+float Noise::gradient2d(const uint32_t seed, const float x, const float y) {
+    return noise_gradient2d<ScalarLanes>(seed, x, y);
+}
+
+float Noise::gradient3d(const uint32_t seed, const float x, const float y, const float z) {
+    return noise_gradient3d<ScalarLanes>(seed, x, y, z);
+}
+
+float Noise::fbm2d(const uint32_t seed, float x, float y, const int octaves) {
+    auto sum = 0.0f;
+    auto amplitude = 1.0f;
+    auto total_amplitude = 0.0f;
+    for (auto octave = 0; octave < octaves; octave++) {
+        // same steps as noise_fbm2d_grid so single samples match the lattice ones bit for bit
+        sum += gradient2d(seed + static_cast<uint32_t>(octave) * NOISE_OCTAVE_SEED, x, y) * amplitude;
+        total_amplitude += amplitude;
+        amplitude *= 0.5f;
+        x *= 2.0f;
+        y *= 2.0f;
+    }
+    return sum / total_amplitude;
+}
+
+void Noise::fbm2d_grid(const uint32_t seed, const int32_t x, const int32_t z, const int count_x, const int count_z,
+                       const float scale, const int octaves, float *out, const NoiseSimd simd) {
+    switch (simd) {
+#ifdef MINECRAFT_NOISE_AVX2
+        case NoiseSimd::AVX2:
+            noise_fbm2d_grid_avx2(seed, x, z, count_x, count_z, scale, octaves, out);
+            return;
+#endif
+#ifdef __SSE2__
+        case NoiseSimd::SSE2:
+            noise_fbm2d_grid<Sse2Lanes>(seed, x, z, count_x, count_z, scale, octaves, out);
+            return;
+#endif
+        default:
+            noise_fbm2d_grid<ScalarLanes>(seed, x, z, count_x, count_z, scale, octaves, out);
+    }
+}
+
+void Noise::gradient3d_grid(const uint32_t seed, const int32_t x, const int32_t y, const int32_t z, const int count_x,
+                            const int count_y, const int count_z, const int32_t spacing, const float scale, float *out,
+                            const NoiseSimd simd) {
+    switch (simd) {
+#ifdef MINECRAFT_NOISE_AVX2
+        case NoiseSimd::AVX2:
+            noise_gradient3d_grid_avx2(seed, x, y, z, count_x, count_y, count_z, spacing, scale, out);
+            return;
+#endif
+#ifdef __SSE2__
+        case NoiseSimd::SSE2:
+            noise_gradient3d_grid<Sse2Lanes>(seed, x, y, z, count_x, count_y, count_z, spacing, scale, out);
+            return;
+#endif
+        default:
+            noise_gradient3d_grid<ScalarLanes>(seed, x, y, z, count_x, count_y, count_z, spacing, scale, out);
+    }
+}
+
+static NoiseSimd detect_simd() {
+#ifdef MINECRAFT_NOISE_AVX2
+    if (__builtin_cpu_supports("avx2")) return NoiseSimd::AVX2;
+#endif
+#ifdef __SSE2__
+    return NoiseSimd::SSE2;
+#else
+    return NoiseSimd::SCALAR;
+#endif
+}
+
+NoiseSimd Noise::best_simd() {
+    static const auto simd = detect_simd();
+    return simd;
+}
+
+const char *Noise::simd_name(const NoiseSimd simd) {
+    switch (simd) {
+        case NoiseSimd::SSE2: return "sse2";
+        case NoiseSimd::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
@@ -0,0 +1,57 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_NOISE_H
+#define MINECRAFT_NOISE_H
+#include <cstdint>
+
+// instruction set the lattice functions run on, every level returns bit identical results
+enum class NoiseSimd {
+    SCALAR = 0,
+    SSE2 = 1,
+    AVX2 = 2,
+};
+
+// Seeded gradient (Perlin) noise. Lattice gradients come from hashing the seed with the lattice coordinates, so
+// there is no permutation table and every seed gives an unrelated, unbounded field.
+// The *_grid functions fill a whole lattice of samples per call (a chunk column plane or a chunk volume) several
+// samples at a time with SSE2 or AVX2, the single sample functions are the same kernel one lane wide.
+struct Noise {
+    // roughly in [-1, 1], 0 on every lattice point
+    static float gradient2d(uint32_t seed, float x, float y);
+
+    // roughly in [-1, 1], 0 on every lattice point
+    static float gradient3d(uint32_t seed, float x, float y, float z);
+
+    // sum of octaves gradient2d layers, each at twice the frequency and half the amplitude of the previous one,
+    // normalized back to roughly [-1, 1]
+    static float fbm2d(uint32_t seed, float x, float y, int octaves);
+
+    // out[i + j * count_x] = fbm2d(seed, float(x + i) / scale, float(z + j) / scale, octaves)
+    static void fbm2d_grid(uint32_t seed, int32_t x, int32_t z, int count_x, int count_z, float scale, int octaves,
+                           float *out, NoiseSimd simd = best_simd());
+
+    // out[i + count_x * (j + count_y * k)] =
+    //     gradient3d(seed, float(x + i * spacing) / scale, float(y + j * spacing) / scale, float(z + k * spacing) / scale)
+    static void gradient3d_grid(uint32_t seed, int32_t x, int32_t y, int32_t z, int count_x, int count_y, int count_z,
+                                int32_t spacing, float scale, float *out, NoiseSimd simd = best_simd());
+
+    // widest level this build and cpu support, detected once
+    static NoiseSimd best_simd();
+
+    static const char *simd_name(NoiseSimd simd);
+
+    static constexpr uint32_t hash(const uint32_t seed, const int32_t x, const int32_t y) {
+        auto h = seed ^ static_cast<uint32_t>(x) * 0x27D4EB2Du ^ static_cast<uint32_t>(y) * 0x165667B1u;
+        h ^= h >> 15;
+        h *= 0x85EBCA77u;
+        h ^= h >> 13;
+        h *= 0xC2B2AE3Du;
+        h ^= h >> 16;
+        return h;
+    }
+};
+
+
+#endif //MINECRAFT_NOISE_H
@@ -0,0 +1,74 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+// Compiled with -mavx2 (see CMakeLists.txt), so nothing here may be reachable before Noise::best_simd() checked the
+// cpu. Keep the includes to the intrinsics and the internal linkage kernel, an inline function from a shared header
+// emitted here could be picked by the linker for the rest of the program.
+#ifdef MINECRAFT_NOISE_AVX2
+#include <immintrin.h>
+
+#include "NoiseKernel.h"
+
+namespace {
+    struct Avx2Lanes {
+        static constexpr int width = 8;
+        using F = __m256;
+        using I = __m256i;
+        using M = __m256;
+
+        static F set(const float value) { return _mm256_set1_ps(value); }
+        static I set_int(const uint32_t value) { return _mm256_set1_epi32(static_cast<int32_t>(value)); }
+
+        static F sequence(const int32_t start, const int32_t step) {
+            const auto lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            return _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(start),
+                                                       _mm256_mullo_epi32(lanes, _mm256_set1_epi32(step))));
+        }
+
+        static void store(float *out, const F value) { _mm256_storeu_ps(out, value); }
+
+        static F add(const F a, const F b) { return _mm256_add_ps(a, b); }
+        static F sub(const F a, const F b) { return _mm256_sub_ps(a, b); }
+        static F mul(const F a, const F b) { return _mm256_mul_ps(a, b); }
+        static F div(const F a, const F b) { return _mm256_div_ps(a, b); }
+
+        static I add_int(const I a, const I b) { return _mm256_add_epi32(a, b); }
+        static I mul_int(const I a, const I b) { return _mm256_mullo_epi32(a, b); }
+        static I xor_int(const I a, const I b) { return _mm256_xor_si256(a, b); }
+
+        template<int bits>
+        static I shift_right(const I a) { return _mm256_srli_epi32(a, bits); }
+
+        static I floor(const F x, F &floor_x) {
+            // same truncate and correct as the other lanes rather than _mm256_floor_ps, so results match exactly
+            auto truncated = _mm256_cvttps_epi32(x);
+            auto truncated_x = _mm256_cvtepi32_ps(truncated);
+            const auto above = _mm256_cmp_ps(truncated_x, x, _CMP_GT_OQ);
+            truncated = _mm256_add_epi32(truncated, _mm256_castps_si256(above));
+            floor_x = _mm256_sub_ps(truncated_x, _mm256_and_ps(above, _mm256_set1_ps(1.0f)));
+            return truncated;
+        }
+
+        static M bit_set(const I a, const uint32_t bit) {
+            const auto bit_lanes = set_int(bit);
+            return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, bit_lanes), bit_lanes));
+        }
+
+        static M select_mask(const M m, const M a, const M b) { return _mm256_blendv_ps(b, a, m); }
+        static F select(const M m, const F a, const F b) { return _mm256_blendv_ps(b, a, m); }
+        static F negate_if(const M m, const F a) { return _mm256_xor_ps(a, _mm256_and_ps(m, _mm256_set1_ps(-0.0f))); }
+    };
+}
+
+void noise_fbm2d_grid_avx2(const uint32_t seed, const int32_t x, const int32_t z, const int count_x, const int count_z,
+                           const float scale, const int octaves, float *out) {
+    noise_fbm2d_grid<Avx2Lanes>(seed, x, z, count_x, count_z, scale, octaves, out);
+}
+
+void noise_gradient3d_grid_avx2(const uint32_t seed, const int32_t x, const int32_t y, const int32_t z,
+                                const int count_x, const int count_y, const int count_z, const int32_t spacing,
+                                const float scale, float *out) {
+    noise_gradient3d_grid<Avx2Lanes>(seed, x, y, z, count_x, count_y, count_z, spacing, scale, out);
+}
+#endif
@@ -0,0 +1,237 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_NOISEKERNEL_H
+#define MINECRAFT_NOISEKERNEL_H
+#include <cstdint>
+
+// Gradient noise written once against a "lanes" type that evaluates Lanes::width samples at a time. The scalar,
+// SSE2 and AVX2 lane types do the same IEEE operations in the same order, so every path returns bit identical noise
+// and the terrain does not depend on the cpu it was generated on. Only included by the noise translation units, the
+// AVX2 one is compiled with -mavx2 and everything here has internal linkage so no AVX2 code leaks into other code.
+namespace {
+    constexpr uint32_t NOISE_HASH_X = 0x27D4EB2Du;
+    constexpr uint32_t NOISE_HASH_Y = 0x165667B1u;
+    constexpr uint32_t NOISE_HASH_Z = 0x9E3779B1u;
+    constexpr uint32_t NOISE_OCTAVE_SEED = 0x9E3779B9u;
+    constexpr float NOISE_DIAGONAL = 0.70710678f;
+
+    struct ScalarLanes {
+        static constexpr int width = 1;
+        using F = float;
+        using I = uint32_t;
+        using M = bool;
+
+        static F set(const float value) { return value; }
+        static I set_int(const uint32_t value) { return value; }
+        // start, start + step, start + 2 * step, ... converted to float
+        static F sequence(const int32_t start, int32_t) { return static_cast<float>(start); }
+        static void store(float *out, const F value) { *out = value; }
+
+        static F add(const F a, const F b) { return a + b; }
+        static F sub(const F a, const F b) { return a - b; }
+        static F mul(const F a, const F b) { return a * b; }
+        static F div(const F a, const F b) { return a / b; }
+
+        static I add_int(const I a, const I b) { return a + b; }
+        static I mul_int(const I a, const I b) { return a * b; }
+        static I xor_int(const I a, const I b) { return a ^ b; }
+        template<int bits>
+        static I shift_right(const I a) { return a >> bits; }
+
+        // floor of x as lattice coordinate (wrapping like a two's complement int) and as float
+        static I floor(const F x, F &floor_x) {
+            auto truncated = static_cast<int32_t>(x);
+            if (static_cast<float>(truncated) > x) truncated--;
+            floor_x = static_cast<float>(truncated);
+            return static_cast<uint32_t>(truncated);
+        }
+
+        static M bit_set(const I a, const uint32_t bit) { return (a & bit) != 0; }
+        static M select_mask(const M m, const M a, const M b) { return m ? a : b; }
+        static F select(const M m, const F a, const F b) { return m ? a : b; }
+        static F negate_if(const M m, const F a) { return m ? -a : a; }
+    };
+
+    template<typename L>
+    typename L::I noise_hash(const typename L::I seed, const typename L::I h) {
+        auto result = L::xor_int(seed, h);
+        result = L::xor_int(result, L::template shift_right<15>(result));
+        result = L::mul_int(result, L::set_int(0x85EBCA77u));
+        result = L::xor_int(result, L::template shift_right<13>(result));
+        result = L::mul_int(result, L::set_int(0xC2B2AE3Du));
+        return L::xor_int(result, L::template shift_right<16>(result));
+    }
+
+    template<typename L>
+    typename L::F noise_fade(const typename L::F t) {
+        // t * t * t * (t * (t * 6 - 15) + 10)
+        const auto inner = L::add(L::mul(t, L::sub(L::mul(t, L::set(6.0f)), L::set(15.0f))), L::set(10.0f));
+        return L::mul(L::mul(L::mul(t, t), t), inner);
+    }
+
+    template<typename L>
+    typename L::F noise_lerp(const typename L::F a, const typename L::F b, const typename L::F t) {
+        return L::add(a, L::mul(L::sub(b, a), t));
+    }
+
+    // eight directions: bit 2 picks diagonal or axis, bits 0/1 the signs (diagonals) or the axis and its sign
+    template<typename L>
+    typename L::F noise_corner2d(const typename L::I hash, const typename L::F dx, const typename L::F dy) {
+        const auto bit0 = L::bit_set(hash, 1);
+        const auto bit1 = L::bit_set(hash, 2);
+        const auto diagonal = L::bit_set(hash, 4);
+        const auto one = L::set(1.0f);
+        const auto zero = L::set(0.0f);
+        const auto s = L::set(NOISE_DIAGONAL);
+
+        const auto gx = L::negate_if(bit0, L::select(diagonal, s, L::select(bit1, zero, one)));
+        const auto gy = L::negate_if(L::select_mask(diagonal, bit1, bit0), L::select(diagonal, s, L::select(bit1, one, zero)));
+        return L::add(L::mul(gx, dx), L::mul(gy, dy));
+    }
+
+    template<typename L>
+    typename L::F noise_gradient2d(const typename L::I seed, const typename L::F x, const typename L::F y) {
+        typename L::F floor_x, floor_y;
+        const auto ix = L::floor(x, floor_x);
+        const auto iy = L::floor(y, floor_y);
+        const auto dx = L::sub(x, floor_x);
+        const auto dy = L::sub(y, floor_y);
+        const auto one = L::set(1.0f);
+        const auto dx1 = L::sub(dx, one);
+        const auto dy1 = L::sub(dy, one);
+
+        const auto hx0 = L::mul_int(ix, L::set_int(NOISE_HASH_X));
+        const auto hx1 = L::mul_int(L::add_int(ix, L::set_int(1)), L::set_int(NOISE_HASH_X));
+        const auto hy0 = L::mul_int(iy, L::set_int(NOISE_HASH_Y));
+        const auto hy1 = L::mul_int(L::add_int(iy, L::set_int(1)), L::set_int(NOISE_HASH_Y));
+
+        const auto c00 = noise_corner2d<L>(noise_hash<L>(seed, L::xor_int(hx0, hy0)), dx, dy);
+        const auto c10 = noise_corner2d<L>(noise_hash<L>(seed, L::xor_int(hx1, hy0)), dx1, dy);
+        const auto c01 = noise_corner2d<L>(noise_hash<L>(seed, L::xor_int(hx0, hy1)), dx, dy1);
+        const auto c11 = noise_corner2d<L>(noise_hash<L>(seed, L::xor_int(hx1, hy1)), dx1, dy1);
+
+        const auto fade_x = noise_fade<L>(dx);
+        const auto bottom = noise_lerp<L>(c00, c10, fade_x);
+        const auto top = noise_lerp<L>(c01, c11, fade_x);
+        // unit gradients peak at sqrt(1/2) in 2D
+        return L::mul(noise_lerp<L>(bottom, top, noise_fade<L>(dy)), L::set(1.41421356f));
+    }
+
+    // the twelve cube edge directions of improved Perlin noise, four of them twice
+    template<typename L>
+    typename L::F noise_corner3d(const typename L::I hash, const typename L::F dx, const typename L::F dy,
+                                 const typename L::F dz) {
+        const auto b0 = L::bit_set(hash, 1);
+        const auto b1 = L::bit_set(hash, 2);
+        const auto b2 = L::bit_set(hash, 4);
+        const auto b3 = L::bit_set(hash, 8);
+        // h < 8 takes x, otherwise y
+        const auto u = L::select(b3, dy, dx);
+        // h < 4 takes y, h 12 and 14 take x, otherwise z
+        const auto v = L::select(b3, L::select(b2, L::select(b0, dz, dx), dz), L::select(b2, dz, dy));
+        return L::add(L::negate_if(b0, u), L::negate_if(b1, v));
+    }
+
+    template<typename L>
+    typename L::F noise_gradient3d(const typename L::I seed, const typename L::F x, const typename L::F y,
+                                   const typename L::F z) {
+        typename L::F floor_x, floor_y, floor_z;
+        const auto ix = L::floor(x, floor_x);
+        const auto iy = L::floor(y, floor_y);
+        const auto iz = L::floor(z, floor_z);
+        const auto one = L::set(1.0f);
+        const auto dx = L::sub(x, floor_x);
+        const auto dy = L::sub(y, floor_y);
+        const auto dz = L::sub(z, floor_z);
+        const auto dx1 = L::sub(dx, one);
+        const auto dy1 = L::sub(dy, one);
+        const auto dz1 = L::sub(dz, one);
+
+        const auto hx0 = L::mul_int(ix, L::set_int(NOISE_HASH_X));
+        const auto hx1 = L::mul_int(L::add_int(ix, L::set_int(1)), L::set_int(NOISE_HASH_X));
+        const auto hy0 = L::mul_int(iy, L::set_int(NOISE_HASH_Y));
+        const auto hy1 = L::mul_int(L::add_int(iy, L::set_int(1)), L::set_int(NOISE_HASH_Y));
+        const auto hz0 = L::mul_int(iz, L::set_int(NOISE_HASH_Z));
+        const auto hz1 = L::mul_int(L::add_int(iz, L::set_int(1)), L::set_int(NOISE_HASH_Z));
+
+        const auto fade_x = noise_fade<L>(dx);
+        const auto fade_y = noise_fade<L>(dy);
+        const auto fade_z = noise_fade<L>(dz);
+
+        const auto c000 = noise_corner3d<L>(noise_hash<L>(seed, L::xor_int(L::xor_int(hx0, hy0), hz0)), dx, dy, dz);
+        const auto c100 = noise_corner3d<L>(noise_hash<L>(seed, L::xor_int(L::xor_int(hx1, hy0), hz0)), dx1, dy, dz);
+        const auto c010 = noise_corner3d<L>(noise_hash<L>(seed, L::xor_int(L::xor_int(hx0, hy1), hz0)), dx, dy1, dz);
+        const auto c110 = noise_corner3d<L>(noise_hash<L>(seed, L::xor_int(L::xor_int(hx1, hy1), hz0)), dx1, dy1, dz);
+        const auto c001 = noise_corner3d<L>(noise_hash<L>(seed, L::xor_int(L::xor_int(hx0, hy0), hz1)), dx, dy, dz1);
+        const auto c101 = noise_corner3d<L>(noise_hash<L>(seed, L::xor_int(L::xor_int(hx1, hy0), hz1)), dx1, dy, dz1);
+        const auto c011 = noise_corner3d<L>(noise_hash<L>(seed, L::xor_int(L::xor_int(hx0, hy1), hz1)), dx, dy1, dz1);
+        const auto c111 = noise_corner3d<L>(noise_hash<L>(seed, L::xor_int(L::xor_int(hx1, hy1), hz1)), dx1, dy1,
+                                            dz1);
+
+        const auto y0 = noise_lerp<L>(noise_lerp<L>(c000, c100, fade_x), noise_lerp<L>(c010, c110, fade_x), fade_y);
+        const auto y1 = noise_lerp<L>(noise_lerp<L>(c001, c101, fade_x), noise_lerp<L>(c011, c111, fade_x), fade_y);
+        return noise_lerp<L>(y0, y1, fade_z);
+    }
+
+    // out[i + j * count_x] = fbm of ((x + i) / scale, (z + j) / scale)
+    template<typename L>
+    void noise_fbm2d_grid(const uint32_t seed, const int32_t x, const int32_t z, const int count_x, const int count_z,
+                          const float scale, const int octaves, float *out) {
+        const auto scale_lanes = L::set(scale);
+        for (auto j = 0; j < count_z; j++) {
+            const auto row_z = L::div(L::set(static_cast<float>(z + j)), scale_lanes);
+            auto i = 0;
+            for (; i + L::width <= count_x; i += L::width) {
+                auto sample_x = L::div(L::sequence(x + i, 1), scale_lanes);
+                auto sample_z = row_z;
+                auto sum = L::set(0.0f);
+                auto amplitude = 1.0f;
+                auto total_amplitude = 0.0f;
+                for (auto octave = 0; octave < octaves; octave++) {
+                    // every octave gets its own seed so the lattices do not line up at the origin
+                    const auto octave_seed = L::set_int(seed + static_cast<uint32_t>(octave) * NOISE_OCTAVE_SEED);
+                    const auto noise = noise_gradient2d<L>(octave_seed, sample_x, sample_z);
+                    sum = L::add(sum, L::mul(noise, L::set(amplitude)));
+                    total_amplitude += amplitude;
+                    amplitude *= 0.5f;
+                    sample_x = L::mul(sample_x, L::set(2.0f));
+                    sample_z = L::mul(sample_z, L::set(2.0f));
+                }
+                L::store(out + i + j * count_x, L::div(sum, L::set(total_amplitude)));
+            }
+            // the columns that do not fill a whole register
+            if (i < count_x)
+                noise_fbm2d_grid<ScalarLanes>(seed, x + i, z + j, count_x - i, 1, scale, octaves, out + i + j * count_x);
+        }
+    }
+
+    // out[i + count_x * (j + count_y * k)] = noise at ((x + i * spacing) / scale, (y + j * spacing) / scale, ...)
+    template<typename L>
+    void noise_gradient3d_grid(const uint32_t seed, const int32_t x, const int32_t y, const int32_t z,
+                               const int count_x, const int count_y, const int count_z, const int32_t spacing,
+                               const float scale, float *out) {
+        const auto scale_lanes = L::set(scale);
+        const auto seed_lanes = L::set_int(seed);
+        for (auto k = 0; k < count_z; k++) {
+            const auto sample_z = L::div(L::set(static_cast<float>(z + k * spacing)), scale_lanes);
+            for (auto j = 0; j < count_y; j++) {
+                const auto sample_y = L::div(L::set(static_cast<float>(y + j * spacing)), scale_lanes);
+                auto *row = out + count_x * (j + count_y * k);
+                auto i = 0;
+                for (; i + L::width <= count_x; i += L::width) {
+                    const auto sample_x = L::div(L::sequence(x + i * spacing, spacing), scale_lanes);
+                    L::store(row + i, noise_gradient3d<L>(seed_lanes, sample_x, sample_y, sample_z));
+                }
+                for (; i < count_x; i++) {
+                    row[i] = noise_gradient3d<ScalarLanes>(seed, static_cast<float>(x + i * spacing) / scale,
+                                                           static_cast<float>(y + j * spacing) / scale,
+                                                           static_cast<float>(z + k * spacing) / scale);
+                }
+            }
+        }
+    }
+}
+
+#endif //MINECRAFT_NOISEKERNEL_H
@@ -0,0 +1,164 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "TerrainGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "Noise.h"
+#include "../World.h"
+
+static float lerp(const float a, const float b, const float t) {
+    return a + (b - a) * t;
+}
+
+int32_t TerrainGenerator::height_at(const int32_t x, const int32_t z) const {
+    const auto noise = Noise::fbm2d(seed, static_cast<float>(x) / TERRAIN_SCALE, static_cast<float>(z) / TERRAIN_SCALE,
+                                    TERRAIN_OCTAVES);
+    return TERRAIN_BASE_HEIGHT + static_cast<int32_t>(std::lround(noise * TERRAIN_AMPLITUDE));
+}
+
+void TerrainGenerator::heightmap(const int32_t x, const int32_t z, int32_t *heights) const {
+    // the whole column plane in one call, bit identical to height_at per column
+    std::array<float, CHUNK_SIZE_X * CHUNK_SIZE_Z> noise;
+    Noise::fbm2d_grid(seed, x, z, CHUNK_SIZE_X, CHUNK_SIZE_Z, TERRAIN_SCALE, TERRAIN_OCTAVES, noise.data());
+    for (size_t i = 0; i < noise.size(); i++)
+        heights[i] = TERRAIN_BASE_HEIGHT + static_cast<int32_t>(std::lround(noise[i] * TERRAIN_AMPLITUDE));
+}
+
+void TerrainGenerator::generate(const ChunkId chunk_id, BlockStorage &blocks) const {
+    const auto [origin_x, origin_y, origin_z] = World::chunk_id_to_world_coordinates(chunk_id);
+    if (above_terrain(origin_y)) {
+        // reset keeps the allocations of a pooled chunk, fill would drop them
+        blocks.reset();
+        return;
+    }
+
+    std::array<int32_t, CHUNK_SIZE_X * CHUNK_SIZE_Z> heights;
+    heightmap(origin_x, origin_z, heights.data());
+    std::array<BlockType, CHUNK_VOLUME> raw;
+    terrain(chunk_id, heights.data(), raw.data());
+    carve(chunk_id, raw.data());
+    blocks.assign(raw.data());
+}
+
+void TerrainGenerator::terrain(const ChunkId chunk_id, const int32_t *heights, BlockType *blocks) const {
+    const auto origin_y = World::chunk_id_to_world_coordinates(chunk_id).y;
+
+    // most chunks are far above or below the surface and never need the per block pass
+    if (above_terrain(origin_y)) {
+        std::fill_n(blocks, CHUNK_VOLUME, BlockType::AIR);
+        return;
+    }
+    if (origin_y + CHUNK_SIZE_Y <= TERRAIN_BASE_HEIGHT - TERRAIN_AMPLITUDE - TERRAIN_DIRT_DEPTH) {
+        std::fill_n(blocks, CHUNK_VOLUME, BlockType::STONE);
+        return;
+    }
+
+    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (auto x = 0; x < CHUNK_SIZE_X; x++) {
+            const auto height = heights[x + z * CHUNK_SIZE_X];
+            for (auto y = 0; y < CHUNK_SIZE_Y; y++) {
+                const auto world_y = origin_y + y;
+                auto type = BlockType::STONE;
+                if (world_y > height) type = BlockType::AIR;
+                else if (world_y == height) type = BlockType::GRASS;
+                else if (world_y > height - 1 - TERRAIN_DIRT_DEPTH) type = BlockType::DIRT;
+                blocks[Chunk::block_index(x, y, z)] = type;
+            }
+        }
+    }
+}
+
+void TerrainGenerator::carve(const ChunkId chunk_id, BlockType *blocks) const {
+    static_assert(CHUNK_SIZE_X == CHUNK_SIZE_Y && CHUNK_SIZE_Y == CHUNK_SIZE_Z, "cave lattice assumes cubic chunks");
+    static_assert(CHUNK_SIZE_Y % CAVE_LATTICE_SPACING == 0, "cave lattice cells have to tile the chunk");
+
+    const auto [origin_x, origin_y, origin_z] = World::chunk_id_to_world_coordinates(chunk_id);
+    if (origin_y >= CAVE_MAX_HEIGHT) return;
+
+    constexpr auto cells = CAVE_LATTICE - 1;
+    constexpr auto step = 1.0f / CAVE_LATTICE_SPACING;
+    std::array<float, CAVE_LATTICE * CAVE_LATTICE * CAVE_LATTICE> first, second;
+    Noise::gradient3d_grid(seed ^ CAVE_SALT_FIRST, origin_x, origin_y, origin_z, CAVE_LATTICE, CAVE_LATTICE,
+                           CAVE_LATTICE, CAVE_LATTICE_SPACING, CAVE_SCALE, first.data());
+    Noise::gradient3d_grid(seed ^ CAVE_SALT_SECOND, origin_x, origin_y, origin_z, CAVE_LATTICE, CAVE_LATTICE,
+                           CAVE_LATTICE, CAVE_LATTICE_SPACING, CAVE_SCALE, second.data());
+
+    for (auto cell_z = 0; cell_z < cells; cell_z++) {
+        for (auto cell_y = 0; cell_y < cells; cell_y++) {
+            for (auto cell_x = 0; cell_x < cells; cell_x++) {
+                // corner i has x, y, z offsets bits 0, 1, 2
+                float a[8], b[8];
+                auto a_low = true, a_high = true, b_low = true, b_high = true;
+                for (auto i = 0; i < 8; i++) {
+                    const auto lattice = (cell_x + (i & 1)) +
+                                         CAVE_LATTICE * ((cell_y + (i >> 1 & 1)) + CAVE_LATTICE * (cell_z + (i >> 2)));
+                    a[i] = first[lattice];
+                    b[i] = second[lattice];
+                    a_low &= a[i] <= -CAVE_THRESHOLD;
+                    a_high &= a[i] >= CAVE_THRESHOLD;
+                    b_low &= b[i] <= -CAVE_THRESHOLD;
+                    b_high &= b[i] >= CAVE_THRESHOLD;
+                }
+                // interpolated values stay between the corners, so a field that is past the threshold on the same
+                // side at all 8 corners cannot get close enough to 0 anywhere in the cell
+                if (a_low || a_high || b_low || b_high) continue;
+
+                for (auto dz = 0; dz < CAVE_LATTICE_SPACING; dz++) {
+                    const auto tz = dz * step;
+                    for (auto dy = 0; dy < CAVE_LATTICE_SPACING; dy++) {
+                        const auto y = cell_y * CAVE_LATTICE_SPACING + dy;
+                        if (origin_y + y >= CAVE_MAX_HEIGHT) break;
+                        const auto ty = dy * step;
+                        // along z then y, leaving the two values to interpolate along x
+                        const auto a0 = lerp(lerp(a[0], a[4], tz), lerp(a[2], a[6], tz), ty);
+                        const auto a1 = lerp(lerp(a[1], a[5], tz), lerp(a[3], a[7], tz), ty);
+                        const auto b0 = lerp(lerp(b[0], b[4], tz), lerp(b[2], b[6], tz), ty);
+                        const auto b1 = lerp(lerp(b[1], b[5], tz), lerp(b[3], b[7], tz), ty);
+                        for (auto dx = 0; dx < CAVE_LATTICE_SPACING; dx++) {
+                            const auto tx = dx * step;
+                            if (!cave_at(lerp(a0, a1, tx), lerp(b0, b1, tx))) continue;
+                            blocks[Chunk::block_index(cell_x * CAVE_LATTICE_SPACING + dx, y,
+                                                      cell_z * CAVE_LATTICE_SPACING + dz)] = BlockType::AIR;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void TerrainGenerator::surface(const BlockType *blocks, ChunkSurface &surface) {
+    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (auto x = 0; x < CHUNK_SIZE_X; x++) {
+            auto &grass = surface[x + z * CHUNK_SIZE_X];
+            grass = -1;
+            for (auto y = CHUNK_SIZE_Y - 1; y >= 0; y--) {
+                const auto type = blocks[Chunk::block_index(x, y, z)];
+                if (type == BlockType::AIR) continue;
+                // the top layer has nothing above it inside the chunk
+                if (type == BlockType::GRASS && y < CHUNK_SIZE_Y - 1) grass = static_cast<int8_t>(y);
+                break;
+            }
+        }
+    }
+}
+
+void TerrainGenerator::surface(const ChunkId chunk_id, ChunkSurface &surface) const {
+    const auto [origin_x, origin_y, origin_z] = World::chunk_id_to_world_coordinates(chunk_id);
+    if (above_terrain(origin_y)) {
+        surface.fill(-1);
+        return;
+    }
+
+    std::array<int32_t, CHUNK_SIZE_X * CHUNK_SIZE_Z> heights;
+    heightmap(origin_x, origin_z, heights.data());
+    std::array<BlockType, CHUNK_VOLUME> raw;
+    terrain(chunk_id, heights.data(), raw.data());
+    carve(chunk_id, raw.data());
+    TerrainGenerator::surface(raw.data(), surface);
+}
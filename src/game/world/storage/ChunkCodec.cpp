@@ -0,0 +1,215 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ChunkCodec.h"
+
+#include <array>
+#include <cstring>
+
+#include "../chunks/Chunk.h"
+
+static_assert(sizeof(BlockType) == 1, "RAW and LZ chunks store one byte per block");
+
+// shortest match worth a sequence, and the hash key length of the match finder
+static constexpr size_t LZ_MIN_MATCH = 4;
+static constexpr uint32_t LZ_HASH_BITS = 12;
+
+void ChunkCodec::encode(const ChunkCodecId codec, const BlockStorage &blocks, std::vector<uint8_t> &out) {
+    out.push_back(static_cast<uint8_t>(codec));
+    if (codec == ChunkCodecId::PALETTE) {
+        blocks.serialize(out);
+        return;
+    }
+
+    std::array<BlockType, CHUNK_VOLUME> raw;
+    blocks.unpack(raw.data());
+    switch (codec) {
+        case ChunkCodecId::RAW:
+            out.insert(out.end(), reinterpret_cast<const uint8_t *>(raw.data()),
+                       reinterpret_cast<const uint8_t *>(raw.data()) + CHUNK_VOLUME);
+            break;
+        case ChunkCodecId::RLE:
+            rle_encode(raw.data(), out);
+            break;
+        case ChunkCodecId::LZ:
+            lz_encode(reinterpret_cast<const uint8_t *>(raw.data()), CHUNK_VOLUME, out);
+            break;
+        case ChunkCodecId::PALETTE:
+            break;
+    }
+}
+
+bool ChunkCodec::decode(const uint8_t *data, const size_t size, BlockStorage &blocks) {
+    if (size == 0) return false;
+
+    const auto codec = static_cast<ChunkCodecId>(data[0]);
+    data++;
+    const auto encoded_size = size - 1;
+    if (codec == ChunkCodecId::PALETTE) return blocks.deserialize(data, encoded_size);
+
+    std::array<BlockType, CHUNK_VOLUME> raw;
+    auto *raw_bytes = reinterpret_cast<uint8_t *>(raw.data());
+    switch (codec) {
+        case ChunkCodecId::RAW:
+            if (encoded_size != CHUNK_VOLUME) return false;
+            std::memcpy(raw_bytes, data, CHUNK_VOLUME);
+            break;
+        case ChunkCodecId::RLE:
+            if (!rle_decode(data, encoded_size, raw.data())) return false;
+            break;
+        case ChunkCodecId::LZ:
+            if (!lz_decode(data, encoded_size, raw_bytes, CHUNK_VOLUME)) return false;
+            break;
+        default:
+            return false;
+    }
+    // a corrupt or foreign payload is regenerated rather than meshed with unknown types
+    for (size_t i = 0; i < CHUNK_VOLUME; i++)
+        if (!is_block_type(raw_bytes[i])) return false;
+    blocks.assign(raw.data());
+    return true;
+}
+
+void ChunkCodec::rle_encode(const BlockType *blocks, std::vector<uint8_t> &out) {
+    auto run_type = BlockType::AIR;
+    uint32_t run = 0;
+    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (auto x = 0; x < CHUNK_SIZE_X; x++) {
+            for (auto y = 0; y < CHUNK_SIZE_Y; y++) {
+                const auto type = blocks[Chunk::block_index(x, y, z)];
+                if (run > 0 && (type != run_type || run == 256)) {
+                    out.push_back(static_cast<uint8_t>(run_type));
+                    out.push_back(static_cast<uint8_t>(run - 1));
+                    run = 0;
+                }
+                run_type = type;
+                run++;
+            }
+        }
+    }
+    out.push_back(static_cast<uint8_t>(run_type));
+    out.push_back(static_cast<uint8_t>(run - 1));
+}
+
+bool ChunkCodec::rle_decode(const uint8_t *data, const size_t size, BlockType *blocks) {
+    if (size % 2 != 0) return false;
+
+    uint32_t run = 0;
+    auto type = BlockType::AIR;
+    size_t in = 0;
+    for (auto z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (auto x = 0; x < CHUNK_SIZE_X; x++) {
+            for (auto y = 0; y < CHUNK_SIZE_Y; y++) {
+                if (run == 0) {
+                    if (in == size || !is_block_type(data[in])) return false;
+                    type = static_cast<BlockType>(data[in]);
+                    run = data[in + 1] + 1u;
+                    in += 2;
+                }
+                blocks[Chunk::block_index(x, y, z)] = type;
+                run--;
+            }
+        }
+    }
+    return run == 0 && in == size;
+}
+
+static void lz_write_length(std::vector<uint8_t> &out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+static void lz_write_sequence(std::vector<uint8_t> &out, const uint8_t *literals, const size_t literal_count,
+                              const size_t offset, const size_t match_length) {
+    const auto literal_nibble = literal_count < 15 ? literal_count : 15;
+    const auto match_extra = match_length == 0 ? 0 : match_length - LZ_MIN_MATCH;
+    const auto match_nibble = match_extra < 15 ? match_extra : 15;
+    out.push_back(static_cast<uint8_t>(literal_nibble << 4 | match_nibble));
+    if (literal_count >= 15) lz_write_length(out, literal_count - 15);
+    out.insert(out.end(), literals, literals + literal_count);
+
+    // the last sequence carries only literals
+    if (match_length == 0) return;
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (match_extra >= 15) lz_write_length(out, match_extra - 15);
+}
+
+static uint32_t lz_hash(const uint8_t *bytes) {
+    uint32_t key;
+    std::memcpy(&key, bytes, sizeof(key));
+    return key * 2654435761u >> (32 - LZ_HASH_BITS);
+}
+
+void ChunkCodec::lz_encode(const uint8_t *data, const size_t size, std::vector<uint8_t> &out) {
+    ASSERT_DEBUG(size <= 65536, "lz offsets are 16 bit");
+
+    // last position + 1 of every hashed 4 byte key, 0 when empty
+    std::array<uint32_t, 1u << LZ_HASH_BITS> table{};
+    size_t literal_start = 0;
+    size_t position = 0;
+    while (position + LZ_MIN_MATCH <= size) {
+        const auto hash = lz_hash(data + position);
+        const auto candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(position + 1);
+
+        if (candidate == 0 || position - (candidate - 1) > 65535 ||
+            std::memcmp(data + candidate - 1, data + position, LZ_MIN_MATCH) != 0) {
+            position++;
+            continue;
+        }
+
+        const auto match = candidate - 1;
+        auto length = LZ_MIN_MATCH;
+        while (position + length < size && data[match + length] == data[position + length]) length++;
+
+        lz_write_sequence(out, data + literal_start, position - literal_start, position - match, length);
+        position += length;
+        literal_start = position;
+    }
+    lz_write_sequence(out, data + literal_start, size - literal_start, 0, 0);
+}
+
+static bool lz_read_length(const uint8_t *data, const size_t data_size, size_t &in, size_t &length) {
+    uint8_t byte;
+    do {
+        if (in == data_size) return false;
+        byte = data[in++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool ChunkCodec::lz_decode(const uint8_t *data, const size_t data_size, uint8_t *out, const size_t size) {
+    size_t in = 0;
+    size_t produced = 0;
+    while (in < data_size) {
+        const auto token = data[in++];
+
+        size_t literal_count = token >> 4;
+        if (literal_count == 15 && !lz_read_length(data, data_size, in, literal_count)) return false;
+        if (literal_count > data_size - in || literal_count > size - produced) return false;
+        std::memcpy(out + produced, data + in, literal_count);
+        in += literal_count;
+        produced += literal_count;
+
+        if (in == data_size) break;
+
+        if (data_size - in < 2) return false;
+        const size_t offset = data[in] | data[in + 1] << 8;
+        in += 2;
+        size_t match_length = token & 15;
+        if (match_length == 15 && !lz_read_length(data, data_size, in, match_length)) return false;
+        match_length += LZ_MIN_MATCH;
+        if (offset == 0 || offset > produced || match_length > size - produced) return false;
+
+        // byte by byte, matches may overlap their own output
+        for (size_t i = 0; i < match_length; i++, produced++)
+            out[produced] = out[produced - offset];
+    }
+    return produced == size;
+}
@@ -0,0 +1,43 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKCODEC_H
+#define MINECRAFT_CHUNKCODEC_H
+#include <cstdint>
+#include <vector>
+
+#include "../chunks/BlockStorage.h"
+
+enum class ChunkCodecId : uint8_t {
+    // CHUNK_VOLUME block bytes in block_index order
+    RAW = 0,
+    // BlockStorage::serialize
+    PALETTE = 1,
+    // (type, run length - 1) byte pairs over the blocks in column order (y fastest), which follows terrain layers
+    RLE = 2,
+    // LZ77 with lz4 style sequences over the RAW bytes
+    LZ = 3,
+};
+
+// Encoded chunks start with their codec id, so payloads written with one codec stay readable after switching the
+// storage to another one.
+struct ChunkCodec {
+    static void encode(ChunkCodecId codec, const BlockStorage &blocks, std::vector<uint8_t> &out);
+
+    // false on an unknown codec or malformed data, blocks is left untouched then
+    static bool decode(const uint8_t *data, size_t size, BlockStorage &blocks);
+
+    static void rle_encode(const BlockType *blocks, std::vector<uint8_t> &out);
+
+    static bool rle_decode(const uint8_t *data, size_t size, BlockType *blocks);
+
+    // inputs up to 64 KiB, offsets are 16 bit
+    static void lz_encode(const uint8_t *data, size_t size, std::vector<uint8_t> &out);
+
+    // fails unless exactly size bytes are produced
+    static bool lz_decode(const uint8_t *data, size_t data_size, uint8_t *out, size_t size);
+};
+
+
+#endif //MINECRAFT_CHUNKCODEC_H
@@ -0,0 +1,118 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ChunkIO.h"
+
+#include <algorithm>
+#include <ctime>
+
+void ChunkIO::request_read(const ChunkId chunk_id) {
+    {
+        std::lock_guard lock(mutex);
+        const auto queued = queued_writes.find(chunk_id);
+        if (queued != queued_writes.end()) {
+            ChunkReadResult result{chunk_id, true, take_spare_blocks()};
+            result.blocks = queued_saves[queued->second].second;
+            finished.push_back(std::move(result));
+            return;
+        }
+        queued_reads++;
+    }
+
+    // a save taken out of queued_writes already is ahead of this read on the io thread
+    thread.submit([this, chunk_id] {
+        auto result = [&] {
+            std::lock_guard lock(mutex);
+            return ChunkReadResult{chunk_id, false, take_spare_blocks()};
+        }();
+        result.found = storage.read(chunk_id, read_buffer) &&
+                       ChunkCodec::decode(read_buffer.data(), read_buffer.size(), result.blocks);
+
+        std::lock_guard lock(mutex);
+        finished.push_back(std::move(result));
+        queued_reads--;
+    });
+}
+
+void ChunkIO::request_save(const Chunk &chunk) {
+    std::lock_guard lock(mutex);
+    const auto queued = queued_writes.find(chunk.id);
+    if (queued != queued_writes.end()) {
+        queued_saves[queued->second].second = chunk.blocks;
+    } else {
+        // copying into a recycled storage reuses its palette and index capacity
+        queued_writes[chunk.id] = static_cast<uint32_t>(queued_saves.size());
+        queued_saves.emplace_back(chunk.id, take_spare_blocks());
+        queued_saves.back().second = chunk.blocks;
+    }
+    if (write_scheduled) return;
+
+    write_scheduled = true;
+    thread.submit([this] { write_batch(); });
+}
+
+void ChunkIO::saved_since(const uint64_t timestamp, std::vector<ChunkId> &out) {
+    // the region files belong to the io thread
+    thread.submit([this, timestamp, &out] { storage.saved_since(timestamp, out); });
+    wait_idle();
+}
+
+void ChunkIO::collect(std::vector<ChunkReadResult> &out) {
+    std::lock_guard lock(mutex);
+    for (auto &result: finished)
+        out.push_back(std::move(result));
+    finished.clear();
+}
+
+void ChunkIO::recycle(BlockStorage &&blocks) {
+    std::lock_guard lock(mutex);
+    spare_blocks.push_back(std::move(blocks));
+}
+
+BlockStorage ChunkIO::take_blocks() {
+    std::lock_guard lock(mutex);
+    return take_spare_blocks();
+}
+
+BlockStorage ChunkIO::take_spare_blocks() {
+    if (spare_blocks.empty()) return {};
+    auto blocks = std::move(spare_blocks.back());
+    spare_blocks.pop_back();
+    return blocks;
+}
+
+size_t ChunkIO::pending_writes() {
+    std::lock_guard lock(mutex);
+    return queued_writes.size();
+}
+
+void ChunkIO::write_batch() {
+    {
+        std::lock_guard lock(mutex);
+        batch.swap(queued_saves);
+        queued_writes.clear();
+        write_scheduled = false;
+    }
+
+    // one region after the other, in the order of their table entries
+    std::sort(batch.begin(), batch.end(), [](const auto &a, const auto &b) {
+        const auto region_a = RegionStorage::region_key(a.first);
+        const auto region_b = RegionStorage::region_key(b.first);
+        if (region_a != region_b) return region_a < region_b;
+        return RegionStorage::region_index(a.first) < RegionStorage::region_index(b.first);
+    });
+    // debug_output belongs to the main thread, failures are only counted here
+    const auto now = static_cast<uint32_t>(std::time(nullptr));
+    for (auto &[chunk_id, blocks]: batch) {
+        write_buffer.clear();
+        ChunkCodec::encode(WORLD_STORAGE_CODEC, blocks, write_buffer);
+        if (!storage.write(chunk_id, write_buffer, now)) failed_writes++;
+    }
+    if (!storage.flush()) failed_writes++;
+
+    std::lock_guard lock(mutex);
+    for (auto &[chunk_id, blocks]: batch)
+        spare_blocks.push_back(std::move(blocks));
+    batch.clear();
+}
@@ -0,0 +1,89 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKIO_H
+#define MINECRAFT_CHUNKIO_H
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "ChunkCodec.h"
+#include "RegionStorage.h"
+#include "../../../utils/ThreadPool.h"
+
+struct ChunkReadResult {
+    ChunkId chunk_id;
+    // false when the chunk was never saved or its payload did not decode
+    bool found;
+    // decoded on the io thread
+    BlockStorage blocks;
+};
+
+// Runs all region file access on one dedicated thread. Reads are decoded there and come back through collect().
+// Saves queue a copy of the block storage per chunk, so saving a chunk again before it reached the disk only replaces
+// the queued copy. Queued saves are encoded with WORLD_STORAGE_CODEC and written on the io thread as one batch sorted
+// by region, then flushed once. A read of a chunk that still has a queued save is answered from that save.
+class ChunkIO {
+    RegionStorage storage;
+    std::mutex mutex;
+    // index into queued_saves per chunk, both are only cleared so their capacity stays for the next batch
+    FlatHashMap<ChunkId, uint32_t> queued_writes{};
+    std::vector<std::pair<ChunkId, BlockStorage> > queued_saves{};
+    bool write_scheduled = false;
+    std::vector<ChunkReadResult> finished{};
+    // storages handed back through recycle() or by written saves, reads decode and saves copy into them
+    std::vector<BlockStorage> spare_blocks{};
+    std::atomic<size_t> queued_reads{0};
+    std::atomic<size_t> failed_writes{0};
+    // io thread only
+    std::vector<uint8_t> read_buffer{};
+    std::vector<uint8_t> write_buffer{};
+    // swapped with queued_saves by write_batch
+    std::vector<std::pair<ChunkId, BlockStorage> > batch{};
+    // one worker keeps reads and writes in submission order, declared last so it stops before the rest is destroyed
+    ThreadPool thread{1};
+
+    void write_batch();
+
+    // a recycled storage when there is one, callers hold mutex
+    BlockStorage take_spare_blocks();
+
+public:
+    explicit ChunkIO(std::filesystem::path directory) : storage(std::move(directory)) {
+    }
+
+    ChunkIO(const ChunkIO &) = delete;
+
+    ChunkIO &operator=(const ChunkIO &) = delete;
+
+    // everything still queued is written before returning
+    ~ChunkIO() { wait_idle(); }
+
+    void request_read(ChunkId chunk_id);
+
+    void request_save(const Chunk &chunk);
+
+    // moves the finished reads into out
+    void collect(std::vector<ChunkReadResult> &out);
+
+    // a storage for a read answered outside of io, given back through recycle() like the others
+    BlockStorage take_blocks();
+
+    // gives back the storage of a collected read once it is no longer needed, so its allocations are reused
+    void recycle(BlockStorage &&blocks);
+
+    // chunks saved at or after timestamp (unix seconds), blocks until the region files were scanned
+    void saved_since(uint64_t timestamp, std::vector<ChunkId> &out);
+
+    void wait_idle() { thread.wait_idle(); }
+
+    [[nodiscard]] size_t pending_reads() const { return queued_reads; }
+
+    [[nodiscard]] size_t pending_writes();
+
+    [[nodiscard]] size_t write_failures() const { return failed_writes; }
+};
+
+
+#endif //MINECRAFT_CHUNKIO_H
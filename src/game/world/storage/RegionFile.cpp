@@ -0,0 +1,145 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "RegionFile.h"
+
+#include <algorithm>
+
+#include "../../../utils/Assert.h"
+#include "../../../utils/Bytes.h"
+
+bool RegionFile::open(const std::filesystem::path &path, const bool create) {
+    std::error_code error;
+    const auto exists = std::filesystem::exists(path, error);
+    if (!exists && !create) return false;
+
+    if (!exists) {
+        std::ofstream created(path, std::ios::binary);
+        const std::vector<char> header(HEADER_SECTORS * REGION_SECTOR_SIZE, 0);
+        created.write(header.data(), static_cast<std::streamsize>(header.size()));
+        if (!created) return false;
+    }
+
+    file.open(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file) return false;
+
+    std::vector<uint8_t> header(2 * TABLE_BYTES);
+    file.read(reinterpret_cast<char *>(header.data()), static_cast<std::streamsize>(header.size()));
+    if (!file) {
+        file.close();
+        return false;
+    }
+
+    const auto size = std::filesystem::file_size(path, error);
+    const auto total_sectors = static_cast<uint32_t>((size + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+    used_sectors.assign(std::max(total_sectors, HEADER_SECTORS), false);
+    mark_sectors(0, HEADER_SECTORS, true);
+
+    for (uint32_t i = 0; i < REGION_CHUNKS; i++) {
+        const auto location = read_le<uint32_t>(header.data() + i * sizeof(uint32_t));
+        const auto first = location >> 8;
+        const auto count = location & 0xFF;
+        // entries pointing outside the file or into the header are treated as missing
+        if (location == 0 || count == 0 || first < HEADER_SECTORS || first + count > used_sectors.size()) {
+            locations[i] = 0;
+            continue;
+        }
+        locations[i] = location;
+        timestamps[i] = read_le<uint32_t>(header.data() + TABLE_BYTES + i * sizeof(uint32_t));
+        mark_sectors(first, count, true);
+    }
+    return true;
+}
+
+bool RegionFile::read(const uint32_t index, std::vector<uint8_t> &payload) {
+    ASSERT_DEBUG(index < REGION_CHUNKS, "chunk index outside the region");
+    const auto location = locations[index];
+    if (location == 0) return false;
+
+    const auto first = location >> 8;
+    const auto capacity = (location & 0xFF) * REGION_SECTOR_SIZE - sizeof(uint32_t);
+
+    uint8_t length_bytes[sizeof(uint32_t)];
+    file.seekg(static_cast<std::streamoff>(first) * REGION_SECTOR_SIZE);
+    file.read(reinterpret_cast<char *>(length_bytes), sizeof(length_bytes));
+    const auto length = read_le<uint32_t>(length_bytes);
+    if (!file || length > capacity) {
+        file.clear();
+        return false;
+    }
+
+    payload.resize(length);
+    file.read(reinterpret_cast<char *>(payload.data()), length);
+    if (!file) {
+        file.clear();
+        return false;
+    }
+    return true;
+}
+
+bool RegionFile::write(const uint32_t index, const uint8_t *data, const uint32_t size, const uint32_t timestamp) {
+    ASSERT_DEBUG(index < REGION_CHUNKS, "chunk index outside the region");
+    const auto needed = static_cast<uint32_t>((sizeof(uint32_t) + size + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+    ASSERT(needed <= 0xFF, "chunk payload does not fit the sector count of a region location");
+
+    auto first = locations[index] >> 8;
+    const auto count = locations[index] & 0xFF;
+    if (needed <= count) {
+        mark_sectors(first + needed, count - needed, false);
+    } else {
+        mark_sectors(first, count, false);
+        first = find_free_sectors(needed);
+    }
+    if (first + needed > used_sectors.size()) used_sectors.resize(first + needed, false);
+    mark_sectors(first, needed, true);
+
+    // padded to whole sectors so the file always ends on a sector boundary
+    static constexpr char padding[REGION_SECTOR_SIZE]{};
+    uint8_t length_bytes[sizeof(uint32_t)];
+    write_le(length_bytes, size);
+    file.seekp(static_cast<std::streamoff>(first) * REGION_SECTOR_SIZE);
+    file.write(reinterpret_cast<const char *>(length_bytes), sizeof(length_bytes));
+    file.write(reinterpret_cast<const char *>(data), size);
+    file.write(padding, static_cast<std::streamsize>(needed * REGION_SECTOR_SIZE - sizeof(uint32_t) - size));
+
+    locations[index] = first << 8 | needed;
+    timestamps[index] = timestamp;
+    uint8_t entry_bytes[sizeof(uint32_t)];
+    write_le(entry_bytes, locations[index]);
+    file.seekp(static_cast<std::streamoff>(index) * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char *>(entry_bytes), sizeof(entry_bytes));
+    write_le(entry_bytes, timestamp);
+    file.seekp(static_cast<std::streamoff>(TABLE_BYTES + index * sizeof(uint32_t)));
+    file.write(reinterpret_cast<const char *>(entry_bytes), sizeof(entry_bytes));
+
+    if (!file) {
+        file.clear();
+        return false;
+    }
+    return true;
+}
+
+bool RegionFile::flush() {
+    file.flush();
+    if (!file) {
+        file.clear();
+        return false;
+    }
+    return true;
+}
+
+void RegionFile::mark_sectors(const uint32_t first, const uint32_t count, const bool used) {
+    for (auto sector = first; sector < first + count; sector++)
+        used_sectors[sector] = used;
+}
+
+uint32_t RegionFile::find_free_sectors(const uint32_t count) const {
+    uint32_t run = 0;
+    for (uint32_t sector = HEADER_SECTORS; sector < used_sectors.size(); sector++) {
+        run = used_sectors[sector] ? 0 : run + 1;
+        if (run == count) return sector + 1 - count;
+    }
+    // a free run touching the end of the file can grow into new sectors
+    return static_cast<uint32_t>(used_sectors.size()) - run;
+}
@@ -0,0 +1,56 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_REGIONFILE_H
+#define MINECRAFT_REGIONFILE_H
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "../WorldConstants.h"
+
+// One file holding up to REGION_CHUNKS chunk payloads in REGION_SECTOR_SIZE sectors.
+// The header is two tables with one little endian uint32 per chunk: the locations, (first sector << 8) | sector count,
+// 0 when the chunk was never written, then the unix time in seconds of the last write of every chunk. Each payload
+// starts with its uint32 length. A payload that outgrows its sectors moves to the first free run of sectors, or to the
+// end of the file.
+class RegionFile {
+    std::fstream file{};
+    std::array<uint32_t, REGION_CHUNKS> locations{};
+    std::array<uint32_t, REGION_CHUNKS> timestamps{};
+    std::vector<bool> used_sectors{};
+
+    void mark_sectors(uint32_t first, uint32_t count, bool used);
+
+    [[nodiscard]] uint32_t find_free_sectors(uint32_t count) const;
+
+public:
+    static constexpr uint32_t TABLE_BYTES = REGION_CHUNKS * sizeof(uint32_t);
+    static constexpr uint32_t HEADER_SECTORS = (2 * TABLE_BYTES + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE;
+
+    // false when the file does not exist (and create is false) or cannot be opened
+    bool open(const std::filesystem::path &path, bool create);
+
+    [[nodiscard]] bool is_open() const { return file.is_open(); }
+
+    [[nodiscard]] bool contains(const uint32_t index) const { return locations[index] != 0; }
+
+    // unix time in seconds of the last write of the chunk, only meaningful when contains(index)
+    [[nodiscard]] uint32_t timestamp(const uint32_t index) const { return timestamps[index]; }
+
+    // replaces payload, false when the chunk is not in this region or the file is damaged
+    bool read(uint32_t index, std::vector<uint8_t> &payload);
+
+    // buffered until flush(), so a batch of writes reaches the disk together
+    bool write(uint32_t index, const uint8_t *data, uint32_t size, uint32_t timestamp);
+
+    bool flush();
+
+    [[nodiscard]] size_t sector_count() const { return used_sectors.size(); }
+};
+
+
+#endif //MINECRAFT_REGIONFILE_H
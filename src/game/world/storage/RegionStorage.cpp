@@ -0,0 +1,95 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "RegionStorage.h"
+
+#include <cstdio>
+
+#include "../World.h"
+
+static WorldCoord region_coords(const ChunkId chunk_id) {
+    const auto [x, y, z] = World::chunk_id_to_chunk_coords(chunk_id);
+    return {World::floor_div(x, REGION_SIZE), World::floor_div(y, REGION_SIZE), World::floor_div(z, REGION_SIZE)};
+}
+
+uint32_t RegionStorage::region_index(const ChunkId chunk_id) {
+    const auto [x, y, z] = World::chunk_id_to_chunk_coords(chunk_id);
+    const auto [region_x, region_y, region_z] = region_coords(chunk_id);
+    const auto local_x = static_cast<uint32_t>(x - region_x * REGION_SIZE);
+    const auto local_y = static_cast<uint32_t>(y - region_y * REGION_SIZE);
+    const auto local_z = static_cast<uint32_t>(z - region_z * REGION_SIZE);
+    return local_x + REGION_SIZE * (local_y + REGION_SIZE * local_z);
+}
+
+ChunkId RegionStorage::region_key(const ChunkId chunk_id) {
+    const auto [x, y, z] = region_coords(chunk_id);
+    return World::chunk_id_from_chunk_coords(x, y, z);
+}
+
+std::string RegionStorage::region_file_name(const ChunkId chunk_id) {
+    const auto [x, y, z] = region_coords(chunk_id);
+    return "r." + std::to_string(x) + "." + std::to_string(y) + "." + std::to_string(z) + ".region";
+}
+
+RegionFile *RegionStorage::region(const ChunkId chunk_id, const bool create) {
+    const auto key = region_key(chunk_id);
+    // a region known to be missing is not looked up on disk again until something is saved into it
+    const auto it = regions.find(key);
+    if (it != regions.end() && (it->second || !create)) return it->second.get();
+
+    std::error_code error;
+    if (create) std::filesystem::create_directories(directory, error);
+
+    auto file = std::make_unique<RegionFile>();
+    auto &region = regions[key];
+    if (file->open(directory / region_file_name(chunk_id), create)) region = std::move(file);
+    return region.get();
+}
+
+bool RegionStorage::read(const ChunkId chunk_id, std::vector<uint8_t> &payload) {
+    auto *file = region(chunk_id, false);
+    if (file == nullptr) return false;
+
+    const auto index = region_index(chunk_id);
+    return file->contains(index) && file->read(index, payload);
+}
+
+bool RegionStorage::write(const ChunkId chunk_id, const std::vector<uint8_t> &payload, const uint32_t timestamp) {
+    auto *file = region(chunk_id, true);
+    if (file == nullptr) return false;
+
+    return file->write(region_index(chunk_id), payload.data(), static_cast<uint32_t>(payload.size()), timestamp);
+}
+
+void RegionStorage::saved_since(const uint64_t timestamp, std::vector<ChunkId> &out) {
+    std::error_code error;
+    for (const auto &entry: std::filesystem::directory_iterator(directory, error)) {
+        int32_t x, y, z;
+        int length = 0;
+        const auto name = entry.path().filename().string();
+        if (std::sscanf(name.c_str(), "r.%d.%d.%d.region%n", &x, &y, &z, &length) != 3 ||
+            static_cast<size_t>(length) != name.size())
+            continue;
+
+        const auto origin = World::chunk_id_from_chunk_coords(x * REGION_SIZE, y * REGION_SIZE, z * REGION_SIZE);
+        auto *file = region(origin, false);
+        if (file == nullptr) continue;
+
+        for (uint32_t index = 0; index < REGION_CHUNKS; index++) {
+            if (!file->contains(index) || file->timestamp(index) < timestamp) continue;
+            const auto local_x = static_cast<int32_t>(index % REGION_SIZE);
+            const auto local_y = static_cast<int32_t>(index / REGION_SIZE % REGION_SIZE);
+            const auto local_z = static_cast<int32_t>(index / (REGION_SIZE * REGION_SIZE));
+            out.push_back(World::chunk_id_from_chunk_coords(x * REGION_SIZE + local_x, y * REGION_SIZE + local_y,
+                                                            z * REGION_SIZE + local_z));
+        }
+    }
+}
+
+bool RegionStorage::flush() {
+    auto flushed = true;
+    for (auto &[key, file]: regions)
+        if (file) flushed &= file->flush();
+    return flushed;
+}
@@ -0,0 +1,50 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_REGIONSTORAGE_H
+#define MINECRAFT_REGIONSTORAGE_H
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "RegionFile.h"
+#include "../chunks/Chunk.h"
+#include "../../../utils/FlatHashMap.h"
+
+// Maps chunks to region files inside one save directory. Region files stay open once touched, regions that do not
+// exist on disk are only created by the first save into them. Payloads are opaque, ChunkIO stores ChunkCodec output.
+// Not thread safe, ChunkIO keeps it on its own thread.
+class RegionStorage {
+    std::filesystem::path directory;
+    // keyed like chunks, by the packed region coordinates; null when the file does not exist yet
+    FlatHashMap<ChunkId, std::unique_ptr<RegionFile> > regions{};
+
+    RegionFile *region(ChunkId chunk_id, bool create);
+
+public:
+    explicit RegionStorage(std::filesystem::path directory) : directory(std::move(directory)) {
+    }
+
+    // false when the chunk was never saved
+    bool read(ChunkId chunk_id, std::vector<uint8_t> &payload);
+
+    bool write(ChunkId chunk_id, const std::vector<uint8_t> &payload, uint32_t timestamp);
+
+    // appends every chunk of the region files in the directory that was written at or after timestamp (unix seconds)
+    void saved_since(uint64_t timestamp, std::vector<ChunkId> &out);
+
+    // pushes buffered writes of every open region to disk
+    bool flush();
+
+    // packed region coordinates, sorting by it groups the chunks of one region file
+    static ChunkId region_key(ChunkId chunk_id);
+
+    // index of the chunk inside its region file
+    static uint32_t region_index(ChunkId chunk_id);
+
+    static std::string region_file_name(ChunkId chunk_id);
+};
+
+
+#endif //MINECRAFT_REGIONSTORAGE_H
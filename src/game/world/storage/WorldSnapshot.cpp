@@ -0,0 +1,229 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+// the platform headers go first, windows.h redefines APIENTRY after glad
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "WorldSnapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+#include "../World.h"
+
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x534E434D; // "MCNS"
+static constexpr uint32_t SNAPSHOT_VERSION = 2;
+static constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+static constexpr size_t pages_for(const size_t bytes) {
+    return (bytes + WORLD_SNAPSHOT_PAGE_SIZE - 1) / WORLD_SNAPSHOT_PAGE_SIZE;
+}
+
+static std::filesystem::path next_path(const std::filesystem::path &path) {
+    auto next = path;
+    next += WORLD_SNAPSHOT_NEXT_SUFFIX;
+    return next;
+}
+
+bool WorldSnapshot::open(const std::filesystem::path &path) {
+    close();
+
+    // nothing maps path now, so a snapshot baked during the last run can take its place
+    const auto next = next_path(path);
+    std::error_code error;
+    if (std::filesystem::exists(next, error)) {
+        std::filesystem::rename(next, path, error);
+        if (error) PRINT_DEBUG("could not replace " << path.string() << " with the baked snapshot: " << error.message());
+    }
+
+#ifdef _WIN32
+    const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+        CloseHandle(file);
+        return false;
+    }
+
+    const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const auto *view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr) {
+        if (mapping != nullptr) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    file_handle = file;
+    mapping_handle = mapping;
+    data = static_cast<const uint8_t *>(view);
+    size = static_cast<size_t>(file_size.QuadPart);
+#else
+    const auto file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat file_stat{};
+    if (fstat(file, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(file);
+        return false;
+    }
+
+    auto *view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, file, 0);
+    // the mapping keeps the file alive on its own
+    ::close(file);
+    if (view == MAP_FAILED) return false;
+
+    data = static_cast<const uint8_t *>(view);
+    size = static_cast<size_t>(file_stat.st_size);
+#endif
+
+    const auto &stored = header();
+    if (stored.magic != SNAPSHOT_MAGIC || stored.version != SNAPSHOT_VERSION ||
+        stored.byte_order != SNAPSHOT_BYTE_ORDER ||
+        sizeof(Header) + static_cast<size_t>(stored.chunk_count) * sizeof(Entry) > size) {
+        PRINT_DEBUG("ignoring incompatible world snapshot " << path.string());
+        close();
+        return false;
+    }
+    return true;
+}
+
+void WorldSnapshot::close() {
+    if (data == nullptr) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mapping_handle);
+    CloseHandle(file_handle);
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+#else
+    munmap(const_cast<uint8_t *>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+const WorldSnapshot::Entry *WorldSnapshot::find(const ChunkId chunk_id) const {
+    const auto *entries = reinterpret_cast<const Entry *>(data + sizeof(Header));
+    const auto *end = entries + header().chunk_count;
+    const auto *entry = std::lower_bound(entries, end, chunk_id, [](const Entry &e, const ChunkId id) {
+        return e.chunk_id < id;
+    });
+    return entry != end && entry->chunk_id == chunk_id ? entry : nullptr;
+}
+
+bool WorldSnapshot::map_chunk(Chunk &chunk) const {
+    if (!is_open()) return false;
+
+    const auto *entry = find(chunk.id);
+    if (entry == nullptr) return false;
+
+    if (entry->bits == 0) {
+        if (!is_block_type(entry->uniform_type)) return false;
+        const auto type = static_cast<BlockType>(entry->uniform_type);
+        chunk.blocks.map(0, &type, 1, nullptr);
+        return true;
+    }
+
+    if (entry->bits != 1 && entry->bits != 2 && entry->bits != 4 && entry->bits != 8) return false;
+    const auto offset = static_cast<size_t>(entry->first_page) * WORLD_SNAPSHOT_PAGE_SIZE;
+    const auto words_bytes = BlockStorage::packed_words(entry->bits) * sizeof(uint64_t);
+    const auto palette_slots = size_t{1} << entry->bits;
+    if (entry->palette_count == 0 || entry->palette_count > palette_slots ||
+        offset + words_bytes + entry->palette_count > size)
+        return false;
+
+    // the packed indices are not scanned, so the palette is padded to every index bits can hold: a stray one reads air
+    std::array<BlockType, 256> palette{};
+    const auto *stored_palette = data + offset + words_bytes;
+    for (size_t i = 0; i < entry->palette_count; i++) {
+        if (!is_block_type(stored_palette[i])) return false;
+        palette[i] = static_cast<BlockType>(stored_palette[i]);
+    }
+    chunk.blocks.map(entry->bits, palette.data(), palette_slots, reinterpret_cast<const uint64_t *>(data + offset));
+    return true;
+}
+
+bool WorldSnapshot::bake(const World &world, const std::filesystem::path &path) {
+    std::vector<const Chunk *> chunks;
+    chunks.reserve(world.chunks.size());
+    for (auto &[chunk_id, chunk]: world.chunks)
+        if (chunk->isInitialized()) chunks.push_back(chunk);
+    std::sort(chunks.begin(), chunks.end(), [](const Chunk *a, const Chunk *b) { return a->id < b->id; });
+
+    const Header stored{
+        SNAPSHOT_MAGIC, SNAPSHOT_VERSION, SNAPSHOT_BYTE_ORDER, static_cast<uint32_t>(chunks.size()),
+        static_cast<uint64_t>(std::time(nullptr))
+    };
+    std::vector<Entry> entries;
+    entries.reserve(chunks.size());
+    auto next_page = static_cast<uint32_t>(pages_for(sizeof(Header) + chunks.size() * sizeof(Entry)));
+    for (const auto *chunk: chunks) {
+        const auto &blocks = chunk->blocks;
+        Entry entry{chunk->id, 0, static_cast<uint16_t>(blocks.palette_size()), blocks.bits_per_block(), 0};
+        if (blocks.is_uniform()) {
+            entry.uniform_type = static_cast<uint8_t>(blocks.uniform_type());
+        } else {
+            entry.first_page = next_page;
+            next_page += static_cast<uint32_t>(pages_for(
+                BlockStorage::packed_words(entry.bits) * sizeof(uint64_t) + entry.palette_count));
+        }
+        entries.push_back(entry);
+    }
+
+    // the mapped snapshot cannot be replaced while it is open on every platform, open() moves this one in place
+    const auto next = next_path(path);
+    auto temporary = next;
+    temporary += ".tmp";
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&stored), sizeof(stored));
+        file.write(reinterpret_cast<const char *>(entries.data()),
+                   static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+
+        std::vector<char> padding(WORLD_SNAPSHOT_PAGE_SIZE, 0);
+        for (size_t i = 0; i < chunks.size(); i++) {
+            const auto &blocks = chunks[i]->blocks;
+            if (blocks.is_uniform()) continue;
+
+            const auto position = static_cast<size_t>(file.tellp());
+            const auto page_start = static_cast<size_t>(entries[i].first_page) * WORLD_SNAPSHOT_PAGE_SIZE;
+            file.write(padding.data(), static_cast<std::streamsize>(page_start - position));
+
+            const auto words_bytes = BlockStorage::packed_words(entries[i].bits) * sizeof(uint64_t);
+            file.write(reinterpret_cast<const char *>(blocks.word_data()), static_cast<std::streamsize>(words_bytes));
+            file.write(reinterpret_cast<const char *>(blocks.palette_data()), entries[i].palette_count);
+        }
+        const auto position = static_cast<size_t>(file.tellp());
+        file.write(padding.data(), static_cast<std::streamsize>(
+                       static_cast<size_t>(next_page) * WORLD_SNAPSHOT_PAGE_SIZE - position));
+        if (!file) {
+            PRINT_DEBUG("failed writing the world snapshot " << temporary.string());
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, next, error);
+    if (error) {
+        PRINT_DEBUG("failed moving the world snapshot to " << next.string() << ": " << error.message());
+        return false;
+    }
+    return true;
+}
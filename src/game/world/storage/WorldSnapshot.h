@@ -0,0 +1,88 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_WORLDSNAPSHOT_H
+#define MINECRAFT_WORLDSNAPSHOT_H
+#include <cstdint>
+#include <filesystem>
+
+#include "../chunks/Chunk.h"
+
+struct World;
+
+// Read only, memory mapped world file whose chunks are used in place: map_chunk points the block storage of a chunk
+// at its packed indices inside the mapping, so loading is a binary search plus a palette copy and the page cache
+// decides what stays in memory. Chunks copy their indices out on the first write.
+//
+// Layout, all in host byte order: a header, the index (one entry per chunk, sorted by chunk id), then every packed
+// chunk starting on its own WORLD_SNAPSHOT_PAGE_SIZE page as index words followed by the palette. Uniform chunks
+// live entirely in their index entry. Entries are checked against the file size, bit widths and block types before a
+// chunk is mapped.
+class WorldSnapshot {
+public:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        // 0x01020304 as written by the baking host, a different byte order fails open()
+        uint32_t byte_order;
+        uint32_t chunk_count;
+        // unix time in seconds, region saves from then on are newer than the snapshot
+        uint64_t baked_at;
+    };
+
+    struct Entry {
+        ChunkId chunk_id;
+        uint32_t first_page;
+        uint16_t palette_count;
+        uint8_t bits;
+        uint8_t uniform_type;
+    };
+
+    static_assert(sizeof(Header) == 24 && sizeof(Entry) == 16, "snapshot structs are written as they are in memory");
+
+    WorldSnapshot() = default;
+
+    WorldSnapshot(const WorldSnapshot &) = delete;
+
+    WorldSnapshot &operator=(const WorldSnapshot &) = delete;
+
+    ~WorldSnapshot() { close(); }
+
+    // false when the file is missing or not a snapshot of this host. A snapshot baked since the last open replaces
+    // the file first.
+    bool open(const std::filesystem::path &path);
+
+    // every chunk mapped from this snapshot must be unloaded or written to first
+    void close();
+
+    [[nodiscard]] bool is_open() const { return data != nullptr; }
+
+    [[nodiscard]] size_t chunk_count() const { return is_open() ? header().chunk_count : 0; }
+
+    [[nodiscard]] uint64_t baked_at() const { return is_open() ? header().baked_at : 0; }
+
+    [[nodiscard]] bool contains(const ChunkId chunk_id) const { return is_open() && find(chunk_id) != nullptr; }
+
+    // false when the chunk is not part of the snapshot
+    bool map_chunk(Chunk &chunk) const;
+
+    // writes every loaded chunk of the world next to path (WORLD_SNAPSHOT_NEXT_SUFFIX), the next open() of path
+    // switches to it. A mapped older snapshot stays intact until then.
+    static bool bake(const World &world, const std::filesystem::path &path);
+
+private:
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void *file_handle = nullptr;
+    void *mapping_handle = nullptr;
+#endif
+
+    [[nodiscard]] const Header &header() const { return *reinterpret_cast<const Header *>(data); }
+
+    [[nodiscard]] const Entry *find(ChunkId chunk_id) const;
+};
+
+
+#endif //MINECRAFT_WORLDSNAPSHOT_H
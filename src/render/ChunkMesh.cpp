@@ -0,0 +1,88 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ChunkMesh.h"
+
+#include <utility>
+
+ChunkMesh::ChunkMesh(ChunkMesh &&other) noexcept : vao(std::exchange(other.vao, 0)),
+                                                   vbo(std::exchange(other.vbo, 0)),
+                                                   quad_count(std::exchange(other.quad_count, 0)),
+                                                   origin(other.origin),
+                                                   visibility(other.visibility),
+                                                   visible_frame(other.visible_frame) {
+}
+
+ChunkMesh &ChunkMesh::operator=(ChunkMesh &&other) noexcept {
+    if (this != &other) {
+        destroy();
+        vao = std::exchange(other.vao, 0);
+        vbo = std::exchange(other.vbo, 0);
+        quad_count = std::exchange(other.quad_count, 0);
+        origin = other.origin;
+        visibility = other.visibility;
+        visible_frame = other.visible_frame;
+    }
+    return *this;
+}
+
+ChunkMesh::~ChunkMesh() {
+    destroy();
+}
+
+void ChunkMesh::upload(const std::vector<ChunkVertex> &vertices, const glm::vec3 &chunk_origin,
+                       const unsigned int quad_ebo) {
+    if (vao == 0) {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad_ebo);
+
+        glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(ChunkVertex), static_cast<void *>(0));
+        glEnableVertexAttribArray(0);
+    } else {
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(ChunkVertex), vertices.data(), GL_STATIC_DRAW);
+    quad_count = static_cast<GLsizei>(vertices.size() / QUAD_VERTICES);
+    origin = chunk_origin;
+    glBindVertexArray(0);
+}
+
+void ChunkMesh::draw(const GLint origin_location) const {
+    if (quad_count == 0) return;
+
+    glUniform3f(origin_location, origin.x, origin.y, origin.z);
+    glBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, quad_count * QUAD_INDICES, GL_UNSIGNED_SHORT, nullptr);
+}
+
+void ChunkMesh::destroy() {
+    if (vao == 0) return;
+
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    vao = 0;
+    vbo = 0;
+    quad_count = 0;
+}
+
+unsigned int ChunkMesh::create_quad_index_buffer() {
+    std::vector<uint16_t> indices;
+    indices.reserve(CHUNK_MAX_QUADS * QUAD_INDICES);
+    for (uint32_t quad = 0; quad < CHUNK_MAX_QUADS; quad++)
+        for (const auto index: quadIndices)
+            indices.push_back(static_cast<uint16_t>(quad * QUAD_VERTICES + index));
+
+    unsigned int ebo;
+    glGenBuffers(1, &ebo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    return ebo;
+}
@@ -0,0 +1,57 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKMESH_H
+#define MINECRAFT_CHUNKMESH_H
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/vec3.hpp>
+
+#include "../game/world/chunks/ChunkMesher.h"
+#include "../game/world/chunks/ChunkVisibility.h"
+
+struct ChunkMesh {
+    unsigned int vao = 0;
+    unsigned int vbo = 0;
+    GLsizei quad_count = 0;
+    // world position of the chunk, vertices are relative to it
+    glm::vec3 origin{};
+    ChunkVisibility visibility = ChunkVisibility::all_connected();
+    // last frame the occlusion culler reached this chunk
+    uint32_t visible_frame = 0;
+
+    ChunkMesh() = default;
+
+    ChunkMesh(const ChunkMesh &) = delete;
+
+    ChunkMesh &operator=(const ChunkMesh &) = delete;
+
+    ChunkMesh(ChunkMesh &&other) noexcept;
+
+    ChunkMesh &operator=(ChunkMesh &&other) noexcept;
+
+    ~ChunkMesh();
+
+    // replaces the whole buffer, creating the vao/vbo on first upload, quad_ebo is bound to the vao
+    void upload(const std::vector<ChunkVertex> &vertices, const glm::vec3 &chunk_origin, unsigned int quad_ebo);
+
+    // blocks are centered on integer coordinates
+    [[nodiscard]] glm::vec3 bounds_min() const { return origin - 0.5f; }
+
+    [[nodiscard]] glm::vec3 bounds_max() const {
+        return bounds_min() + glm::vec3(CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z);
+    }
+
+    // expects the chunk shader to be bound, origin_location is its chunkOrigin uniform
+    void draw(GLint origin_location) const;
+
+    void destroy();
+
+    // 16 bit indices for CHUNK_MAX_QUADS quads, shared by every chunk mesh
+    static unsigned int create_quad_index_buffer();
+};
+
+
+#endif //MINECRAFT_CHUNKMESH_H
@@ -0,0 +1,55 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ChunkMeshBuilder.h"
+
+#include <memory>
+
+#include "../game/world/World.h"
+
+void ChunkMeshBuilder::request(const World &world, const ChunkId chunk_id, const MeshingMode mode) {
+    const auto &chunk = world.getChunk(chunk_id);
+    ASSERT_DEBUG(chunk.isInitialized(), "meshing a chunk that is still generating");
+    const auto revision = ++next_revision;
+    latest_revision[chunk_id] = revision;
+
+    // nothing to mesh and nothing to flood fill in an all air chunk
+    if (chunk.blocks.is_uniform() && chunk.blocks.uniform_type() == BlockType::AIR) {
+        std::lock_guard lock(finished_mutex);
+        finished.push_back({chunk_id, revision, {}, ChunkVisibility::all_connected()});
+        return;
+    }
+
+    auto snapshot = std::make_shared<ChunkSnapshot>();
+    ChunkSnapshot::capture(chunk, *snapshot);
+
+    workers.submit([this, snapshot, revision, mode] {
+        ChunkMeshResult result{snapshot->id, revision, {}, {}};
+        ChunkMesher::mesh(*snapshot, mode, result.vertices);
+        result.visibility = ChunkVisibility::compute(*snapshot);
+
+        std::lock_guard lock(finished_mutex);
+        finished.push_back(std::move(result));
+    });
+}
+
+void ChunkMeshBuilder::cancel(const ChunkId chunk_id) {
+    latest_revision.erase(chunk_id);
+}
+
+void ChunkMeshBuilder::collect(std::vector<ChunkMeshResult> &out) {
+    std::vector<ChunkMeshResult> ready;
+    {
+        std::lock_guard lock(finished_mutex);
+        ready.swap(finished);
+    }
+
+    for (auto &result: ready) {
+        const auto it = latest_revision.find(result.chunk_id);
+        if (it == latest_revision.end() || it->second != result.revision) continue;
+
+        latest_revision.erase(it);
+        out.push_back(std::move(result));
+    }
+}
@@ -0,0 +1,56 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_CHUNKMESHBUILDER_H
+#define MINECRAFT_CHUNKMESHBUILDER_H
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../game/world/chunks/ChunkMesher.h"
+#include "../game/world/chunks/ChunkVisibility.h"
+#include "../utils/ThreadPool.h"
+
+struct World;
+
+struct ChunkMeshResult {
+    ChunkId chunk_id;
+    uint32_t revision;
+    std::vector<ChunkVertex> vertices;
+    ChunkVisibility visibility;
+};
+
+// Meshes chunks on a worker pool. Snapshots are taken on the calling (main) thread, meshing runs on the workers and
+// finished vertex buffers are handed back through collect() so they can be uploaded on the gl thread.
+struct ChunkMeshBuilder {
+    explicit ChunkMeshBuilder(size_t threads = 0) : workers(threads) {
+    }
+
+    // queues a (re)mesh, any older pending result of the same chunk is dropped when collected
+    void request(const World &world, ChunkId chunk_id, MeshingMode mode = WORLD_MESHING_MODE);
+
+    // forget the chunk, pending results for it are dropped
+    void cancel(ChunkId chunk_id);
+
+    // moves every finished, up to date mesh into out
+    void collect(std::vector<ChunkMeshResult> &out);
+
+    void wait_idle() { workers.wait_idle(); }
+
+    [[nodiscard]] size_t pending() const { return latest_revision.size(); }
+
+private:
+    uint32_t next_revision = 0;
+    // only touched by the main thread
+    std::unordered_map<ChunkId, uint32_t> latest_revision{};
+
+    std::mutex finished_mutex;
+    std::vector<ChunkMeshResult> finished{};
+
+    // last member so the workers are joined before the queue they write to is destroyed
+    ThreadPool workers;
+};
+
+
+#endif //MINECRAFT_CHUNKMESHBUILDER_H
@@ -0,0 +1,45 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_FRUSTUM_H
+#define MINECRAFT_FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+struct Frustum {
+    // left, right, bottom, top, near, far as (normal, distance), normals point inside
+    glm::vec4 planes[6];
+
+    // planes of the clip space cube pulled back to world space (Gribb/Hartmann)
+    static Frustum from_matrix(const glm::mat4 &view_projection) {
+        Frustum frustum{};
+        const auto row = [&view_projection](const int i) {
+            return glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i],
+                             view_projection[3][i]);
+        };
+
+        for (auto axis = 0; axis < 3; axis++) {
+            frustum.planes[axis * 2] = row(3) + row(axis);
+            frustum.planes[axis * 2 + 1] = row(3) - row(axis);
+        }
+
+        for (auto &plane: frustum.planes)
+            plane /= glm::length(glm::vec3(plane));
+        return frustum;
+    }
+
+    [[nodiscard]] bool intersects_aabb(const glm::vec3 &min, const glm::vec3 &max) const {
+        for (const auto &plane: planes) {
+            // corner furthest along the plane normal, if it is outside the whole box is
+            const glm::vec3 positive(plane.x >= 0 ? max.x : min.x,
+                                     plane.y >= 0 ? max.y : min.y,
+                                     plane.z >= 0 ? max.z : min.z);
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0) return false;
+        }
+        return true;
+    }
+};
+
+
+#endif //MINECRAFT_FRUSTUM_H
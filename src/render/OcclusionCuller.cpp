@@ -0,0 +1,45 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "OcclusionCuller.h"
+
+#include <cmath>
+
+#include "../game/world/World.h"
+
+bool OcclusionCuller::mark_visible(std::unordered_map<ChunkId, ChunkMesh> &meshes, const glm::vec3 &camera,
+                                   const Frustum &frustum, const uint32_t frame) {
+    const auto camera_chunk_id = World::chunk_id_from_world_coords({
+        static_cast<int32_t>(std::floor(camera.x + 0.5f)),
+        static_cast<int32_t>(std::floor(camera.y + 0.5f)),
+        static_cast<int32_t>(std::floor(camera.z + 0.5f))
+    });
+    const auto camera_chunk = meshes.find(camera_chunk_id);
+    if (camera_chunk == meshes.end()) return false;
+
+    camera_chunk->second.visible_frame = frame;
+    queue.push_back({camera_chunk_id, -1, 0});
+
+    while (!queue.empty()) {
+        const auto step = queue.front();
+        queue.pop_front();
+        const auto &visibility = meshes.at(step.chunk_id).visibility;
+
+        for (auto face = 0; face < CUBE_FACES; face++) {
+            // opposite faces are paired in directions[]
+            const auto opposite = face ^ 1;
+            if (step.taken >> opposite & 1) continue;
+            if (step.entry_face >= 0 && !visibility.connected(step.entry_face, face)) continue;
+
+            const auto neighbor_id = World::neighbor_chunk_id(step.chunk_id, face);
+            const auto neighbor = meshes.find(neighbor_id);
+            if (neighbor == meshes.end() || neighbor->second.visible_frame == frame) continue;
+            if (!frustum.intersects_aabb(neighbor->second.bounds_min(), neighbor->second.bounds_max())) continue;
+
+            neighbor->second.visible_frame = frame;
+            queue.push_back({neighbor_id, opposite, static_cast<uint8_t>(step.taken | 1 << face)});
+        }
+    }
+    return true;
+}
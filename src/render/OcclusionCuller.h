@@ -0,0 +1,34 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_OCCLUSIONCULLER_H
+#define MINECRAFT_OCCLUSIONCULLER_H
+#include <deque>
+#include <unordered_map>
+
+#include "ChunkMesh.h"
+#include "Frustum.h"
+
+// Breadth first walk from the camera chunk through chunk faces that can see each other (ChunkVisibility),
+// never stepping back against a direction already taken and never leaving the frustum.
+struct OcclusionCuller {
+    // stamps visible_frame = frame on every reachable mesh, returns false (and stamps nothing) when the camera is
+    // not inside a meshed chunk
+    bool mark_visible(std::unordered_map<ChunkId, ChunkMesh> &meshes, const glm::vec3 &camera,
+                      const Frustum &frustum, uint32_t frame);
+
+private:
+    struct Step {
+        ChunkId chunk_id;
+        // face of this chunk the walk came through, -1 for the camera chunk
+        int entry_face;
+        // bitmask of the directions[] taken so far
+        uint8_t taken;
+    };
+
+    std::deque<Step> queue;
+};
+
+
+#endif //MINECRAFT_OCCLUSIONCULLER_H
@@ -4,6 +4,9 @@
 
 #include "Render.h"
 
+#include <algorithm>
+#include <limits>
+
 Render::Render(World &world) : world(world) {
     yaw = -90.0f;
     pitch = 0.0f;
@@ -11,7 +14,6 @@ Render::Render(World &world) : world(world) {
     lastY = HEIGHT / 2.0f;
     firstMouse = true;
     mouseEnabled = true;
-    visibleVertices = world.generate_visible_vertices();
 
     if (!glfwInit()) {
         std::cerr << "failed to init GLFW\n";
@@ -55,8 +57,9 @@ Render::Render(World &world) : world(world) {
 
     glGenTextures(1, &texture);
     glBindTexture(GL_TEXTURE_2D, texture);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // greedy meshed quads span several blocks and tile the texture with uv > 1
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
@@ -82,27 +85,29 @@ Render::Render(World &world) : world(world) {
 
     DebugGui::setup(window);
 
-    ASSERT_DEBUG(visibleVertices.size() < WORLD_MAX_VERTICES,
-                 "created more vertices than possible in this implementation (something wrong with culling?)");
-    PRINT_DEBUG("Total vertices: " << visibleVertices.size()
-        << " max: " << WORLD_MAX_VERTICES
-        << " culling: " << (static_cast<double>(visibleVertices.size()) / WORLD_MAX_VERTICES * 100.0) << "%"
-        << std::endl);
-
-    glGenVertexArrays(1, &visibleVAO);
-    glGenBuffers(1, &visibleVBO);
+    quadEBO = ChunkMesh::create_quad_index_buffer();
 
-    glBindVertexArray(visibleVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, visibleVBO);
-    glBufferData(GL_ARRAY_BUFFER, visibleVertices.size() * sizeof(float), visibleVertices.data(), GL_STATIC_DRAW);
+    const auto meshing_start = glfwGetTime();
+    for (auto &[chunk_id, chunk]: world.chunks)
+        if (chunk->isInitialized()) mesh_chunk(chunk_id);
+    mesh_builder.wait_idle();
+    upload_finished_meshes(std::numeric_limits<double>::infinity());
+    PRINT_DEBUG("Meshed " << chunk_meshes.size() << " chunks in " << (glfwGetTime() - meshing_start) * 1000.0
+        << "ms");
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), static_cast<void *>(0));
-    glEnableVertexAttribArray(0);
+    size_t total_vertices = 0;
+    for (auto &[chunk_id, mesh]: chunk_meshes)
+        total_vertices += mesh.quad_count * QUAD_VERTICES;
 
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), reinterpret_cast<void *>(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    const auto max_vertices = static_cast<long long>(world.chunks.size()) * CHUNK_UNCULLED_VERTICES;
+    ASSERT_DEBUG(static_cast<long long>(total_vertices) < max_vertices,
+                 "created more vertices than possible in this implementation (something wrong with culling?)");
+    PRINT_DEBUG("Total vertices: " << total_vertices
+        << " max: " << max_vertices
+        << " culling: " << (static_cast<double>(total_vertices) / max_vertices * 100.0) << "%"
+        << " vertex memory: " << total_vertices * sizeof(ChunkVertex) / 1024 << "KiB"
+        << std::endl);
 
-    glBindVertexArray(0);
     glEnable(GL_DEPTH_TEST);
 }
 
@@ -117,6 +122,7 @@ void Render::render() {
 
     auto player = world.players.at(0);
     player->processInput(window, delta_time);
+    stream_chunks();
 
     glPolygonMode(GL_FRONT_AND_BACK, player->draw_line ? GL_LINE : GL_FILL);
     glUseProgram(shaderProgram);
@@ -135,23 +141,96 @@ void Render::render() {
     unsigned int projLoc = glGetUniformLocation(shaderProgram, "projection");
     glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
 
-    DebugGui::render(this, player);
-    glBindVertexArray(visibleVAO);
-    glDrawArrays(GL_TRIANGLES, 0, visibleVertices.size());
+    const auto frustum = Frustum::from_matrix(projection * view);
+    const auto occlusion = occlusionCulling &&
+                           occlusion_culler.mark_visible(chunk_meshes, player->position, frustum, ++frame);
+    const auto originLoc = glGetUniformLocation(shaderProgram, "chunkOrigin");
+    visible_chunks = 0;
+    culled_chunks = 0;
+    occluded_chunks = 0;
+    for (auto &[chunk_id, mesh]: chunk_meshes) {
+        if (mesh.quad_count == 0) continue;
+
+        if (!frustum.intersects_aabb(mesh.bounds_min(), mesh.bounds_max())) {
+            culled_chunks++;
+            continue;
+        }
+        if (occlusion && mesh.visible_frame != frame) {
+            occluded_chunks++;
+            continue;
+        }
+
+        visible_chunks++;
+        mesh.draw(originLoc);
+    }
     glBindVertexArray(0);
 
+    DebugGui::render(this, player);
+
+    upload_finished_meshes();
+
     glfwSwapBuffers(window);
     glfwPollEvents();
 }
 
 Render::~Render() {
     DebugGui::destroy();
-    glDeleteVertexArrays(1, &visibleVAO);
+    chunk_meshes.clear();
+    glDeleteBuffers(1, &quadEBO);
     glDeleteProgram(shaderProgram);
     glfwDestroyWindow(window);
     glfwTerminate();
 }
 
+void Render::mesh_chunk(const ChunkId chunk_id) {
+    mesh_builder.request(world, chunk_id);
+}
+
+size_t Render::upload_finished_meshes(const double budget_ms) {
+    mesh_builder.collect(pending_uploads);
+
+    const auto start = glfwGetTime();
+    size_t uploaded = 0;
+    while (uploaded < pending_uploads.size() && (glfwGetTime() - start) * 1000.0 < budget_ms) {
+        auto &result = pending_uploads[uploaded++];
+        const auto [x, y, z] = World::chunk_id_to_world_coordinates(result.chunk_id);
+        auto &mesh = chunk_meshes[result.chunk_id];
+        mesh.upload(result.vertices, glm::vec3(x, y, z), quadEBO);
+        mesh.visibility = result.visibility;
+    }
+    pending_uploads.erase(pending_uploads.begin(), pending_uploads.begin() + static_cast<ptrdiff_t>(uploaded));
+    return uploaded;
+}
+
+void Render::remove_chunk_mesh(const ChunkId chunk_id) {
+    mesh_builder.cancel(chunk_id);
+    chunk_meshes.erase(chunk_id);
+    pending_uploads.erase(std::remove_if(pending_uploads.begin(), pending_uploads.end(),
+                                         [&](const ChunkMeshResult &result) { return result.chunk_id == chunk_id; }),
+                          pending_uploads.end());
+}
+
+void Render::stream_chunks() {
+    chunk_streamer.update(world);
+
+    for (const auto chunk_id: chunk_streamer.unloaded)
+        remove_chunk_mesh(chunk_id);
+
+    // a chunk appearing or disappearing changes the border faces of its loaded neighbours
+    std::vector<ChunkId> remesh(chunk_streamer.loaded);
+    for (const auto chunk_id: chunk_streamer.loaded)
+        for (auto face = 0; face < CUBE_FACES; face++)
+            remesh.push_back(World::neighbor_chunk_id(chunk_id, face));
+    for (const auto chunk_id: chunk_streamer.unloaded)
+        for (auto face = 0; face < CUBE_FACES; face++)
+            remesh.push_back(World::neighbor_chunk_id(chunk_id, face));
+
+    std::sort(remesh.begin(), remesh.end());
+    remesh.erase(std::unique(remesh.begin(), remesh.end()), remesh.end());
+    for (const auto chunk_id: remesh)
+        if (world.isChunkInitialized(chunk_id)) mesh_chunk(chunk_id);
+}
+
 void Render::mouse_callback(GLFWwindow *window, double xpos, double ypos) {
     if (!mouseEnabled) return;
 
@@ -199,6 +278,15 @@ void Render::key_callback(GLFWwindow *window, int key, int scancode, int action,
             glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
         }
     }
+
+    if (key == GLFW_KEY_O && action == GLFW_PRESS)
+        occlusionCulling = !occlusionCulling;
+
+    if (key == GLFW_KEY_F5 && action == GLFW_PRESS) {
+        // PRINT_DEBUG compiles to nothing in release builds, the bake has to happen outside of it
+        [[maybe_unused]] const auto baked = world.bake_snapshot();
+        PRINT_DEBUG((baked ? "baked " : "failed baking ") << world.chunks.size() << " chunks into the world snapshot");
+    }
 }
 
 void Render::framebuffer_size_callback([[maybe_unused]] GLFWwindow *window, const int width, const int height) {
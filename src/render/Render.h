@@ -5,8 +5,10 @@
 #ifndef MINECRAFT_GLFW_H
 #define MINECRAFT_GLFW_H
 
+#include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <unordered_map>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
@@ -14,10 +16,15 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "ChunkMesh.h"
+#include "ChunkMeshBuilder.h"
+#include "Frustum.h"
+#include "OcclusionCuller.h"
 #include "ShaderManager.h"
 #include "TextureManager.h"
 #include "../game/GameConstants.h"
 #include "../game/players/Player.h"
+#include "../game/world/ChunkStreamer.h"
 #include "../game/world/World.h"
 #include "../utils/DebugGui.h"
 
@@ -30,23 +37,47 @@ struct Render {
     bool mouseEnabled;
     glm::vec<3, float> cameraFront;
 
-    unsigned int visibleVAO, visibleVBO;
+    unsigned int quadEBO;
     unsigned int shaderProgram;
     unsigned int texture;
     GLFWwindow *window;
 
+    // chunk meshes submitted/skipped by frustum and occlusion culling last frame
+    size_t visible_chunks = 0;
+    size_t culled_chunks = 0;
+    size_t occluded_chunks = 0;
+    bool occlusionCulling = true;
+    uint32_t frame = 0;
+
     float delta_time = 0.0f;
     float lastFrame = 0.0f;
 
     ShaderManager shaderManager{};
     TextureManager textureManager{};
     World &world;
-    std::vector<float> visibleVertices;
+    std::unordered_map<ChunkId, ChunkMesh> chunk_meshes{};
+    // shares the thread budget with the generation pool of the world, both keep at least one worker
+    ChunkMeshBuilder mesh_builder{std::max<size_t>(ThreadPool::thread_budget() - World::generation_threads(), 1)};
+    // finished meshes left over when the upload budget of a frame ran out
+    std::vector<ChunkMeshResult> pending_uploads{};
+    OcclusionCuller occlusion_culler{};
+    ChunkStreamer chunk_streamer{};
 
     explicit Render(World &world);
 
     void render();
 
+    // queues a (re)mesh of a single chunk on the mesh workers, call after any block change inside it or on its borders
+    void mesh_chunk(ChunkId chunk_id);
+
+    // uploads the meshes finished by the workers until budget_ms is spent, must run on the gl thread
+    size_t upload_finished_meshes(double budget_ms = CHUNK_MESH_UPLOAD_BUDGET_MS);
+
+    void remove_chunk_mesh(ChunkId chunk_id);
+
+    // runs the chunk streamer and remeshes whatever its loads and unloads touched
+    void stream_chunks();
+
     ~Render();
 
     [[nodiscard]] bool is_running() const { return !glfwWindowShouldClose(window); }
@@ -0,0 +1,36 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_BYTES_H
+#define MINECRAFT_BYTES_H
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// little endian encoding of integers, independent of the host byte order
+
+template<typename T>
+void write_le(std::vector<uint8_t> &out, const T value) {
+    static_assert(std::is_unsigned_v<T>);
+    for (size_t i = 0; i < sizeof(T); i++)
+        out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+template<typename T>
+void write_le(uint8_t *out, const T value) {
+    static_assert(std::is_unsigned_v<T>);
+    for (size_t i = 0; i < sizeof(T); i++)
+        out[i] = static_cast<uint8_t>(value >> (i * 8));
+}
+
+template<typename T>
+T read_le(const uint8_t *in) {
+    static_assert(std::is_unsigned_v<T>);
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+        value |= static_cast<T>(in[i]) << (i * 8);
+    return value;
+}
+
+#endif //MINECRAFT_BYTES_H
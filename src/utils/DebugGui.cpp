@@ -35,7 +35,25 @@ void DebugGui::render(const Render *render, const std::shared_ptr<Player> &playe
     ImGui::Text("FPS: %.1f", 1.0f / render->delta_time);
     ImGui::Text("Pos: (%.1f, %.1f, %.1f)", player->position.x, player->position.y, player->position.z);
     ImGui::Text("Yaw: %.1f, Pitch: %.1f", render->yaw, render->pitch);
+    const auto column_x = static_cast<int32_t>(std::floor(player->position.x));
+    const auto column_z = static_cast<int32_t>(std::floor(player->position.z));
+    ImGui::Text("Column: terrain %d, highest block %d (%zu columns cached)",
+                render->world.terrain_height(column_x, column_z), render->world.highest_block(column_x, column_z),
+                render->world.columns.size());
     ImGui::Text("Mouse: %s", render->mouseEnabled ? "Enabled" : "Disabled");
+    ImGui::Text("Chunks: %zu visible, %zu culled, %zu occluded", render->visible_chunks, render->culled_chunks,
+                render->occluded_chunks);
+    ImGui::Text("Chunks loaded: %zu (%zu KiB blocks)", render->world.chunks.size(),
+                render->world.chunk_memory_usage() / 1024);
+    const auto &pool = render->world.chunk_pool.stats();
+    ImGui::Text("Chunk pool: %zu slabs, %zu in use, %zu constructed, %zu reused", pool.slabs, pool.in_use,
+                pool.constructed, pool.reused);
+    ImGui::Text("Streaming: %zu loads, %zu unloads, %zu uploads pending", render->chunk_streamer.pending_loads(),
+                render->chunk_streamer.pending_unloads(), render->pending_uploads.size());
+    ImGui::Text("Chunk io: %zu reads, %zu writes queued, %zu failed writes", render->world.io.pending_reads(),
+                render->world.io.pending_writes(), render->world.io.write_failures());
+    ImGui::Text("Snapshot: %zu chunks mapped (F5 to bake the loaded ones)", render->world.snapshot.chunk_count());
+    ImGui::Text("Occlusion culling: %s (O to toggle)", render->occlusionCulling ? "Enabled" : "Disabled");
     ImGui::Text("Press ESC to toggle mouse"); {
         ImGui::BeginChild("Console", ImVec2(0, -ImGui::GetFrameHeightWithSpacing()), false,
                           ImGuiWindowFlags_HorizontalScrollbar);
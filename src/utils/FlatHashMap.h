@@ -0,0 +1,175 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_FLATHASHMAP_H
+#define MINECRAFT_FLATHASHMAP_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Open addressing hash map with linear probing over one flat array of entries. Erasing shifts the following entries
+// of the probe run back instead of leaving tombstones. Keys and values must be default constructible and movable.
+// Any insert or erase invalidates iterators and references to entries (not to what a pointer value points at).
+template<typename K, typename V, typename Hash = std::hash<K> >
+class FlatHashMap {
+public:
+    // same member names as std::pair so map code reads the same
+    struct Entry {
+        K first{};
+        V second{};
+    };
+
+    template<bool Const>
+    class Iterator {
+        using Map = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+        using Reference = std::conditional_t<Const, const Entry &, Entry &>;
+        using Pointer = std::conditional_t<Const, const Entry *, Entry *>;
+
+        Map *map;
+        size_t slot;
+
+        void skip_empty() {
+            while (slot < map->used.size() && !map->used[slot]) slot++;
+        }
+
+    public:
+        Iterator(Map *map, const size_t slot) : map(map), slot(slot) { skip_empty(); }
+
+        Reference operator*() const { return map->entries[slot]; }
+
+        Pointer operator->() const { return &map->entries[slot]; }
+
+        Iterator &operator++() {
+            slot++;
+            skip_empty();
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const { return slot == other.slot; }
+
+        bool operator!=(const Iterator &other) const { return slot != other.slot; }
+
+        friend class FlatHashMap;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() { rehash(16); }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, used.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, used.size()); }
+
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] size_t capacity() const { return used.size(); }
+
+    iterator find(const K &key) { return iterator(this, find_slot(key)); }
+
+    const_iterator find(const K &key) const { return const_iterator(this, find_slot(key)); }
+
+    [[nodiscard]] bool contains(const K &key) const { return find_slot(key) != used.size(); }
+
+    V &operator[](const K &key) {
+        auto slot = home(key);
+        while (used[slot]) {
+            if (entries[slot].first == key) return entries[slot].second;
+            slot = (slot + 1) & mask;
+        }
+
+        // keep the load factor at or below 3/4
+        if ((count + 1) * 4 > used.size() * 3) {
+            rehash(used.size() * 2);
+            return (*this)[key];
+        }
+
+        used[slot] = true;
+        entries[slot].first = key;
+        count++;
+        return entries[slot].second;
+    }
+
+    void erase(const iterator it) { erase_slot(it.slot); }
+
+    bool erase(const K &key) {
+        const auto slot = find_slot(key);
+        if (slot == used.size()) return false;
+
+        erase_slot(slot);
+        return true;
+    }
+
+    void clear() {
+        entries.assign(entries.size(), Entry{});
+        used.assign(used.size(), false);
+        count = 0;
+    }
+
+    void reserve(const size_t elements) {
+        auto slots = used.size();
+        while (elements * 4 > slots * 3) slots *= 2;
+        if (slots != used.size()) rehash(slots);
+    }
+
+private:
+    std::vector<Entry> entries;
+    std::vector<uint8_t> used;
+    size_t count = 0;
+    size_t mask = 0;
+    uint32_t shift = 64;
+
+    // fibonacci hashing spreads clustered keys (neighbouring chunk ids) over the whole table
+    [[nodiscard]] size_t home(const K &key) const {
+        return static_cast<size_t>(static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull >> shift);
+    }
+
+    [[nodiscard]] size_t find_slot(const K &key) const {
+        auto slot = home(key);
+        while (used[slot]) {
+            if (entries[slot].first == key) return slot;
+            slot = (slot + 1) & mask;
+        }
+        return used.size();
+    }
+
+    void erase_slot(size_t slot) {
+        entries[slot] = Entry{};
+        used[slot] = false;
+        count--;
+
+        // pull back every following entry of the run that may live in the hole
+        for (auto next = (slot + 1) & mask; used[next]; next = (next + 1) & mask) {
+            const auto ideal = home(entries[next].first);
+            if (((next - ideal) & mask) < ((next - slot) & mask)) continue;
+
+            entries[slot] = std::move(entries[next]);
+            entries[next] = Entry{};
+            used[slot] = true;
+            used[next] = false;
+            slot = next;
+        }
+    }
+
+    void rehash(const size_t slots) {
+        auto old_entries = std::move(entries);
+        auto old_used = std::move(used);
+
+        entries = std::vector<Entry>(slots);
+        used.assign(slots, false);
+        mask = slots - 1;
+        shift = 64;
+        for (auto size = slots; size > 1; size >>= 1) shift--;
+
+        count = 0;
+        for (size_t i = 0; i < old_used.size(); i++)
+            if (old_used[i]) (*this)[old_entries[i].first] = std::move(old_entries[i].second);
+    }
+};
+
+
+#endif //MINECRAFT_FLATHASHMAP_H
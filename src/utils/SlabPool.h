@@ -0,0 +1,90 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_SLABPOOL_H
+#define MINECRAFT_SLABPOOL_H
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Assert.h"
+
+struct SlabPoolStats {
+    size_t slabs = 0;
+    // objects constructed in slab memory so far
+    size_t constructed = 0;
+    size_t in_use = 0;
+    // acquires served from the free list, without touching the heap
+    size_t reused = 0;
+};
+
+// Slab allocator for objects that are handed out and given back all the time. Released objects stay constructed on a
+// free list and are reset when acquired again, T(args...) and T::reset(args...) have to leave the same state, so
+// whatever capacity T holds (block storage, vectors) is reused and steady state streaming does not allocate.
+template<typename T, size_t SLAB_SIZE>
+class SlabPool {
+    struct Slab {
+        alignas(T) unsigned char storage[sizeof(T) * SLAB_SIZE];
+
+        T *at(const size_t index) { return reinterpret_cast<T *>(storage) + index; }
+    };
+
+    std::vector<std::unique_ptr<Slab> > slabs{};
+    // objects constructed in the last slab
+    size_t slab_used = SLAB_SIZE;
+    std::vector<T *> free_objects{};
+    SlabPoolStats pool_stats{};
+
+public:
+    SlabPool() = default;
+
+    SlabPool(const SlabPool &) = delete;
+
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    ~SlabPool() {
+        for (size_t slab = 0; slab < slabs.size(); slab++) {
+            const auto constructed = slab + 1 == slabs.size() ? slab_used : SLAB_SIZE;
+            for (size_t i = 0; i < constructed; i++)
+                slabs[slab]->at(i)->~T();
+        }
+    }
+
+    template<typename... Args>
+    [[nodiscard]] T *acquire(Args &&... args) {
+        pool_stats.in_use++;
+
+        if (!free_objects.empty()) {
+            auto *object = free_objects.back();
+            free_objects.pop_back();
+            object->reset(std::forward<Args>(args)...);
+            pool_stats.reused++;
+            return object;
+        }
+
+        if (slab_used == SLAB_SIZE) {
+            slabs.push_back(std::make_unique<Slab>());
+            // every object of the slab may come back at once
+            free_objects.reserve(slabs.size() * SLAB_SIZE);
+            slab_used = 0;
+            pool_stats.slabs++;
+        }
+
+        pool_stats.constructed++;
+        return new(slabs.back()->at(slab_used++)) T(std::forward<Args>(args)...);
+    }
+
+    void release(T *object) {
+        ASSERT_DEBUG(pool_stats.in_use > 0, "released more objects than acquired");
+        pool_stats.in_use--;
+        free_objects.push_back(object);
+    }
+
+    [[nodiscard]] const SlabPoolStats &stats() const { return pool_stats; }
+};
+
+
+#endif //MINECRAFT_SLABPOOL_H
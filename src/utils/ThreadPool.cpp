@@ -0,0 +1,73 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) threads = thread_budget();
+
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; i++)
+        workers.emplace_back(&ThreadPool::work, this);
+}
+
+size_t ThreadPool::thread_budget() {
+    const auto hardware_threads = static_cast<size_t>(std::thread::hardware_concurrency());
+    return std::max<size_t>(hardware_threads, 2) - 1;
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    job_available.notify_all();
+    for (auto &worker: workers)
+        worker.join();
+}
+
+void ThreadPool::wait_idle() {
+    std::unique_lock lock(mutex);
+    idle.wait(lock, [this] { return queued == 0 && running == 0; });
+}
+
+void ThreadPool::grow() {
+    std::vector<Job> grown(std::max<size_t>(jobs.size() * 2, 16));
+    for (size_t i = 0; i < queued; i++) {
+        auto &job = jobs[(first + i) % jobs.size()];
+        job.relocate(job.storage, grown[i].storage);
+        grown[i].run = job.run;
+        grown[i].relocate = job.relocate;
+    }
+    jobs.swap(grown);
+    first = 0;
+}
+
+void ThreadPool::work() {
+    Job job;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            job_available.wait(lock, [this] { return stopping || queued > 0; });
+            if (stopping && queued == 0) return;
+
+            auto &next = jobs[first];
+            next.relocate(next.storage, job.storage);
+            job.run = next.run;
+            first = (first + 1) % jobs.size();
+            queued--;
+            running++;
+        }
+
+        job.run(job.storage);
+
+        {
+            std::lock_guard lock(mutex);
+            running--;
+            if (queued == 0 && running == 0) idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,95 @@
+//
+// Created by Luke on 18/10/2026.
+//
+
+#ifndef MINECRAFT_THREADPOOL_H
+#define MINECRAFT_THREADPOOL_H
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct ThreadPool {
+    // bytes a submitted closure may capture, it is stored inline in the queue
+    static constexpr size_t JOB_BYTES = 48;
+
+    // 0 takes the whole thread_budget()
+    explicit ThreadPool(size_t threads = 0);
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool();
+
+    // the closure is moved into the job ring, which only allocates when it grows past its largest backlog so far
+    template<typename F>
+    void submit(F &&job) {
+        using Closure = std::decay_t<F>;
+        static_assert(sizeof(Closure) <= JOB_BYTES && alignof(Closure) <= alignof(std::max_align_t),
+                      "job captures too much, capture a pointer to pooled job data instead");
+        {
+            std::lock_guard lock(mutex);
+            if (queued == jobs.size()) grow();
+            auto &slot = jobs[(first + queued) % jobs.size()];
+            new(slot.storage) Closure(std::forward<F>(job));
+            slot.run = &run_closure<Closure>;
+            slot.relocate = &relocate_closure<Closure>;
+            queued++;
+        }
+        job_available.notify_one();
+    }
+
+    // blocks until the queue is empty and no job is running
+    void wait_idle();
+
+    [[nodiscard]] size_t size() const { return workers.size(); }
+
+    // one worker per hardware thread, leaving one for the main/gl thread. Pools that run at the same time split it.
+    static size_t thread_budget();
+
+private:
+    // a type erased closure, run() calls and destroys it, relocate() moves it into another job's storage
+    struct Job {
+        alignas(std::max_align_t) unsigned char storage[JOB_BYTES];
+        void (*run)(void *) = nullptr;
+        void (*relocate)(void *from, void *to) = nullptr;
+    };
+
+    std::vector<std::thread> workers;
+    // ring of queued jobs starting at first
+    std::vector<Job> jobs;
+    size_t first = 0;
+    size_t queued = 0;
+    std::mutex mutex;
+    std::condition_variable job_available;
+    std::condition_variable idle;
+    size_t running = 0;
+    bool stopping = false;
+
+    template<typename Closure>
+    static void run_closure(void *storage) {
+        auto &closure = *static_cast<Closure *>(storage);
+        closure();
+        closure.~Closure();
+    }
+
+    template<typename Closure>
+    static void relocate_closure(void *from, void *to) {
+        auto &closure = *static_cast<Closure *>(from);
+        new(to) Closure(std::move(closure));
+        closure.~Closure();
+    }
+
+    // doubles the ring, callers hold mutex
+    void grow();
+
+    void work();
+};
+
+
+#endif //MINECRAFT_THREADPOOL_H